@@ -13,7 +13,7 @@ if "%1"=="" (
         echo 🎮 Game features:
         echo    - Red apples that spawn 100%% reliably
         echo    - Score tracking and high score
-        echo    - Optimized EWRAM performance
+        echo    - Packed game state in fast IWRAM
         echo    - Multi-platform architecture ready
     ) else (
         echo ❌ GBA build failed!
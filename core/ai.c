@@ -0,0 +1,288 @@
+// Autopilot - BFS to the food, bitset flood fill safety check, Hamiltonian cycle fallback
+#include "ai.h"
+#include <string.h>
+
+_Static_assert(BOARD_H % 2 == 0, "The Hamiltonian cycle is laid out for an even number of rows");
+
+#define ROW_MASK (0xFFFFFFFFu >> (32 - BOARD_W))
+// Shortcuts leave skipped cells behind the head. Food that lands there is
+// only reached a lap later, and each meal on the way eats into the room
+// ahead of the tail - so skip only while the snake is short and at least
+// half of the free cells stay ahead.
+#define AI_SHORTCUT_LEN (BOARD_CELLS / 2)
+#define AI_MARGIN(len) ((BOARD_CELLS - (len)) / 2)
+#define AI_STALL_STEPS (BOARD_CELLS * 2) // Fallback: steps without food before the cycle is followed unconditionally
+
+// Direction index order matches the turn queue: up, down, left, right
+static const int8_t dir_dx[4] = { 0, 0, -1, 1 };
+static const int8_t dir_dy[4] = { -1, 1, 0, 0 };
+static const uint8_t dir_btn[4] = { BTN_UP, BTN_DOWN, BTN_LEFT, BTN_RIGHT };
+
+// Rotate a row bitset by one cell - rows wrap like the board
+static inline uint32_t row_left(uint32_t r) {
+    return ((r >> 1) | (r << (BOARD_W - 1))) & ROW_MASK;
+}
+
+static inline uint32_t row_right(uint32_t r) {
+    return ((r << 1) | (r >> (BOARD_W - 1))) & ROW_MASK;
+}
+
+static inline int bit_test(const uint32_t* rows, int x, int y) {
+    return (rows[y] >> x) & 1;
+}
+
+static int bit_count(uint32_t v) {
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+// Cycle: row 0 runs right from column 0, the remaining rows snake back and
+// forth over columns 1..W-1, and column 0 leads from the last row back up.
+// Even rows run right, so the snake game_reset lays out (head in the middle
+// of row BOARD_H / 2, body to its left) starts in cycle order.
+static void ai_build_cycle(Ai* ai) {
+    for (int y = 0; y < BOARD_H; y++) {
+        for (int x = 0; x < BOARD_W; x++) {
+            int d;
+            if (x == 0) {
+                d = y == 0 ? 3 : 0;
+            } else if ((y & 1) == 0) {
+                d = x == BOARD_W - 1 ? 1 : 3;
+            } else if (x == 1) {
+                d = y == BOARD_H - 1 ? 2 : 1;
+            } else {
+                d = 2;
+            }
+            ai->cycle[board_cell(x, y)] = d;
+        }
+    }
+
+    int x = 0, y = 0;
+    for (int i = 0; i < BOARD_CELLS; i++) {
+        int d = ai->cycle[board_cell(x, y)];
+        ai->order[board_cell(x, y)] = i;
+        x = board_wrap_x(x + dir_dx[d]);
+        y = board_wrap_y(y + dir_dy[d]);
+    }
+}
+
+// Steps from a to b going forward round the cycle
+static inline int ai_cycle_dist(const Ai* ai, Cell a, Cell b) {
+    int d = ai->order[board_cell(b.x, b.y)] - ai->order[board_cell(a.x, a.y)];
+    return d < 0 ? d + BOARD_CELLS : d;
+}
+
+// Does each segment, head to tail, sit further back along the cycle than the
+// one before, all within one lap?
+static int ai_body_ordered(const Ai* ai, const Game* game) {
+    int lap = 0;
+    int i = game->snake_head;
+    for (int n = 1; n < game->snake_len; n++) {
+        int next = i + 1 == MAX_SNAKE_LEN ? 0 : i + 1;
+        lap += ai_cycle_dist(ai, game->snake[next], game->snake[i]);
+        if (lap >= BOARD_CELLS) return 0;
+        i = next;
+    }
+    return 1;
+}
+
+// Step along the cycle, skipping ahead where a neighbour is further round
+// but still short of the food and AI_MARGIN short of the tail. Keeps the
+// body in cycle order; -1 only if no step qualifies (the tail is the next
+// cell, which game_update treats as a collision).
+static int ai_shortcut(const Ai* ai, const uint32_t* open, Cell head, Cell tail, Cell food, int len) {
+    int to_tail = ai_cycle_dist(ai, head, tail);
+    int to_food = ai_cycle_dist(ai, head, food);
+    int best = -1, best_dist = 0;
+    int reach = len < AI_SHORTCUT_LEN ? to_tail - AI_MARGIN(len) : 1;
+
+    for (int d = 0; d < 4; d++) {
+        Cell n;
+        n.x = board_wrap_x(head.x + dir_dx[d]);
+        n.y = board_wrap_y(head.y + dir_dy[d]);
+        if (!bit_test(open, n.x, n.y)) continue;
+
+        int k = ai_cycle_dist(ai, head, n);
+        if (k >= to_tail || k > to_food || (k > 1 && k > reach)) continue;
+        if (k > best_dist) {
+            best_dist = k;
+            best = d;
+        }
+    }
+    return best;
+}
+
+void ai_init(Ai* ai) {
+    memset(ai, 0, sizeof(Ai));
+    ai_build_cycle(ai);
+    ai->last_head.x = 0xFF;
+    ai->last_head.y = 0xFF;
+}
+
+// Flood `open` from (sx, sy) one ring per pass, rows updated in place so a
+// pass usually spreads further than one cell. Returns 1 if (tx, ty) is
+// reached; with `area` set it runs to completion and counts the cells.
+static int ai_flood(Ai* ai, const uint32_t* open, int sx, int sy, int tx, int ty, int* area) {
+    uint32_t* reach = ai->reach;
+    memset(reach, 0, sizeof(ai->reach));
+    reach[sy] = 1u << sx;
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int y = 0; y < BOARD_H; y++) {
+            uint32_t r = reach[y];
+            uint32_t up = reach[y ? y - 1 : BOARD_H - 1];
+            uint32_t down = reach[y == BOARD_H - 1 ? 0 : y + 1];
+            uint32_t grown = r | ((row_left(r) | row_right(r) | up | down) & open[y]);
+            if (grown != r) {
+                reach[y] = grown;
+                changed = 1;
+            }
+        }
+        if (!area && bit_test(reach, tx, ty)) return 1;
+    }
+
+    if (area) {
+        int n = 0;
+        for (int y = 0; y < BOARD_H; y++) n += bit_count(reach[y]);
+        *area = n;
+    }
+    return bit_test(reach, tx, ty);
+}
+
+// Is stepping in direction d from the head safe - afterwards, can the head
+// still reach the tail (which keeps moving on, so it counts as open for the
+// flood)? Optionally reports the room left.
+static int ai_safe(Ai* ai, const uint32_t* open, Cell head, Cell tail, int d, int* area) {
+    int nx = board_wrap_x(head.x + dir_dx[d]);
+    int ny = board_wrap_y(head.y + dir_dy[d]);
+    if (!bit_test(open, nx, ny)) return 0;
+
+    uint32_t after[BOARD_H];
+    memcpy(after, open, sizeof(after));
+    after[ny] &= ~(1u << nx);
+    after[tail.y] |= 1u << tail.x;
+    return ai_flood(ai, after, nx, ny, tail.x, tail.y, area);
+}
+
+// First step of a shortest path to the food, or -1 if it cannot be reached
+static int ai_bfs(Ai* ai, const uint32_t* open, Cell head, Cell food) {
+    Cell* queue = ai->queue;
+    int qhead = 0, qtail = 0;
+
+    memset(ai->seen, 0, sizeof(ai->seen));
+    ai->seen[head.y] |= 1u << head.x;
+
+    // Seed with the head's neighbours so every later cell inherits its first step
+    for (int d = 0; d < 4; d++) {
+        int nx = board_wrap_x(head.x + dir_dx[d]);
+        int ny = board_wrap_y(head.y + dir_dy[d]);
+        if (!bit_test(open, nx, ny) || bit_test(ai->seen, nx, ny)) continue;
+        if (nx == food.x && ny == food.y) return d;
+
+        ai->seen[ny] |= 1u << nx;
+        ai->first[board_cell(nx, ny)] = d;
+        queue[qtail].x = nx;
+        queue[qtail].y = ny;
+        qtail++;
+    }
+
+    while (qhead < qtail) {
+        Cell c = queue[qhead++];
+        int first = ai->first[board_cell(c.x, c.y)];
+
+        for (int d = 0; d < 4; d++) {
+            int nx = board_wrap_x(c.x + dir_dx[d]);
+            int ny = board_wrap_y(c.y + dir_dy[d]);
+            if (!bit_test(open, nx, ny) || bit_test(ai->seen, nx, ny)) continue;
+            if (nx == food.x && ny == food.y) return first;
+
+            ai->seen[ny] |= 1u << nx;
+            ai->first[board_cell(nx, ny)] = first;
+            queue[qtail].x = nx;
+            queue[qtail].y = ny;
+            qtail++;
+        }
+    }
+    return -1;
+}
+
+int ai_choose(Ai* ai, const Game* game) {
+    Cell head = game->snake[game->snake_head];
+    Cell tail = game->snake[game_snake_tail(game)];
+
+    // Free cells straight from the occupancy grid. The tail cell stays
+    // blocked: game_update tests the grid before the tail moves off.
+    uint32_t open[BOARD_H];
+    for (int y = 0; y < BOARD_H; y++) {
+        open[y] = ~game->grid[y] & ROW_MASK;
+    }
+
+    // Cycle order is checked once per game; every shortcut step keeps it
+    if (ai->ordered) {
+        int d = ai_shortcut(ai, open, head, tail, game->food, game->snake_len);
+        if (d >= 0) return d;
+        ai->ordered = 0;
+    }
+
+    // Fallback. Steps since the last meal - detours can settle into a loop
+    // that never passes the food; the cycle alone visits every cell, so once
+    // stalled follow it whatever happens
+    if (game->snake_len != ai->last_len) {
+        ai->last_len = game->snake_len;
+        ai->stall = 0;
+    } else if (ai->stall < 0xFFFF) {
+        ai->stall++;
+    }
+    if (ai->stall >= AI_STALL_STEPS) return ai->cycle[board_cell(head.x, head.y)];
+
+    // Shortest path to the food, if the snake can still reach its tail after the first step
+    int d = ai_bfs(ai, open, head, game->food);
+    if (d >= 0 && ai_safe(ai, open, head, tail, d, NULL)) return d;
+
+    // Otherwise the safe step with the most room, or failing that any open step
+    int best = -1, best_score = -1;
+    for (d = 0; d < 4; d++) {
+        int area = 0;
+        int safe = ai_safe(ai, open, head, tail, d, &area);
+        int nx = board_wrap_x(head.x + dir_dx[d]);
+        int ny = board_wrap_y(head.y + dir_dy[d]);
+        if (!bit_test(open, nx, ny)) continue;
+
+        int score = safe ? BOARD_CELLS + area : area;
+        if (score > best_score) {
+            best_score = score;
+            best = d;
+        }
+    }
+    if (best >= 0) return best;
+
+    // Boxed in - keep going
+    for (d = 0; d < 4; d++) {
+        if (dir_dx[d] == game->dir_x && dir_dy[d] == game->dir_y) return d;
+    }
+    return 3;
+}
+
+uint32_t ai_buttons(Ai* ai, const Game* game) {
+    // Release last frame's press so the next one is a fresh edge
+    if (ai->pressed) {
+        ai->pressed = 0;
+        return 0;
+    }
+    if (game->state != GAME_PLAYING) return 0;
+
+    // One decision per movement tick: the press is queued and applied on the next step
+    Cell head = game->snake[game->snake_head];
+    if (head.x == ai->last_head.x && head.y == ai->last_head.y) return 0;
+    if (ai->last_head.x == 0xFF) ai->ordered = ai_body_ordered(ai, game);
+    ai->last_head = head;
+
+    int d = ai_choose(ai, game);
+    if (dir_dx[d] == game->dir_x && dir_dy[d] == game->dir_y) return 0;
+
+    ai->pressed = 1;
+    return dir_btn[d];
+}
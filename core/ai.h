@@ -0,0 +1,37 @@
+// Autopilot for Snake - produces Buttons masks for game_update
+// Once per movement tick it picks the next step along a fixed Hamiltonian
+// cycle, cutting corners towards the food only where the body stays in
+// cycle order: then every cell between the head and the tail (going round
+// the cycle) is free, so the snake cannot trap itself and reaches each food
+// within one lap. A decision is a few table lookups - no search - and
+// counts towards the update phase of the profiler overlay on hardware.
+// Games that do not start in cycle order (a snake handed over mid-game)
+// fall back to a BFS path to the food checked with a bitset flood fill,
+// then the roomiest safe neighbour. All working memory lives in the Ai
+// struct - no malloc, no recursion.
+#pragma once
+#include <stdint.h>
+#include "game.h"
+
+typedef struct {
+    Cell queue[BOARD_CELLS];        // BFS frontier
+    uint8_t first[BOARD_CELLS];     // First step (direction index) of the path to each reached cell
+    uint32_t seen[BOARD_H];         // BFS visited set, one bit per cell
+    uint32_t reach[BOARD_H];        // Flood fill scratch
+    uint8_t cycle[BOARD_CELLS];     // Direction index to the next cell on the Hamiltonian cycle
+    uint16_t order[BOARD_CELLS];    // Position of each cell along the cycle
+    Cell last_head;                 // Head position the last decision was made for
+    uint16_t last_len;              // Snake length at the last decision
+    uint16_t stall;                 // Steps since the snake last grew (fallback only)
+    uint8_t ordered;                // Body lies in cycle order - shortcuts are safe
+    uint8_t pressed;                // A direction was sent last frame - release it first
+} Ai;
+
+void ai_init(Ai* ai);
+
+// Input for this frame: at most one direction press per movement tick,
+// released on the following frame so edge detection sees every press
+uint32_t ai_buttons(Ai* ai, const Game* game);
+
+// Direction index (0 up, 1 down, 2 left, 3 right) for the snake's next step
+int ai_choose(Ai* ai, const Game* game);
@@ -0,0 +1,33 @@
+// Attract mode - swaps the player's buttons for the autopilot's on an idle menu
+#include "attract.h"
+#include <string.h>
+
+void attract_init(Attract* at) {
+    memset(at, 0, sizeof(Attract));
+}
+
+uint32_t attract_input(Attract* at, const Game* game, uint32_t buttons) {
+    if (at->swallow) {
+        if (buttons) return 0;
+        at->swallow = 0;
+    }
+    
+    if (game->demo) {
+        if (buttons || game->state == GAME_OVER || game->state == GAME_WON) {
+            // Dropping GAME_INPUT_DEMO sends game_update back to the menu
+            at->idle_frames = 0;
+            at->swallow = buttons != 0;
+            return 0;
+        }
+        return ai_buttons(&at->ai, game) | GAME_INPUT_DEMO;
+    }
+    
+    if (game->state != GAME_MENU || buttons) {
+        at->idle_frames = 0;
+        return buttons;
+    }
+    if (++at->idle_frames < ATTRACT_DELAY) return 0;
+    
+    ai_init(&at->ai);
+    return GAME_INPUT_DEMO;
+}
@@ -0,0 +1,24 @@
+// Attract mode - the autopilot plays from the menu until any key is pressed
+// Sits between the platform's buttons and game_update: after ATTRACT_DELAY
+// idle menu frames it raises GAME_INPUT_DEMO and feeds the autopilot's
+// buttons with it; a key press or the end of the demo game drops the bit.
+// Everything it decides reaches the core as input, so recording what
+// attract_input returns is enough to replay a session with demos in it.
+#pragma once
+#include <stdint.h>
+#include "game.h"
+#include "ai.h"
+
+#define ATTRACT_DELAY 600   // Idle menu frames (~10 s) before the autopilot demo starts
+
+typedef struct {
+    Ai ai;
+    uint32_t idle_frames;
+    uint8_t swallow;        // Keys that ended the demo - ignored until released
+} Attract;
+
+void attract_init(Attract* at);
+
+// Input for game_update this frame: the player's buttons, or the autopilot's
+// plus GAME_INPUT_DEMO while a demo runs
+uint32_t attract_input(Attract* at, const Game* game, uint32_t buttons);
@@ -0,0 +1,42 @@
+// Packed BCD counters for Snake - 8 decimal digits in a uint32_t
+// The ARM7TDMI has no divide instruction, so counters shown on screen are
+// kept in BCD and updated with a carry-correcting add; drawing a digit is
+// then a shift and a mask instead of a libgcc division per digit.
+#pragma once
+#include <stdint.h>
+
+#define BCD_DIGITS 8
+
+// a + b for packed BCD operands (carry out of the top digit is lost)
+static inline uint32_t bcd_add(uint32_t a, uint32_t b) {
+    uint32_t t1 = a + 0x06666666;     // Pre-bias every digit so a decimal carry becomes a nibble carry
+    uint32_t t2 = t1 + b;
+    uint32_t t3 = t1 ^ b;
+    uint32_t carries = ~(t2 ^ t3) & 0x11111110;
+    return t2 - ((carries >> 2) | (carries >> 3)); // Take the bias back out of digits that did not carry
+}
+
+// Binary to packed BCD by shift-and-add-3 (double dabble) - no division.
+// Leading zero bits and digits are skipped, so small values (the profiling
+// overlay) cost a few dozen steps
+static inline uint32_t bcd_from_uint(uint32_t v) {
+    uint32_t bcd = 0;
+    int bit = 31;
+    while (bit >= 0 && !((v >> bit) & 1)) bit--;
+
+    for (; bit >= 0; bit--) {
+        // Add 3 to every digit >= 5 before doubling
+        for (int d = 0; d < BCD_DIGITS && (bcd >> (d * 4)); d++) {
+            if (((bcd >> (d * 4)) & 0xF) >= 5) bcd += 3u << (d * 4);
+        }
+        bcd = (bcd << 1) | ((v >> bit) & 1);
+    }
+    return bcd;
+}
+
+// Number of significant digits (at least 1)
+static inline int bcd_length(uint32_t bcd) {
+    int n = BCD_DIGITS;
+    while (n > 1 && ((bcd >> ((n - 1) * 4)) & 0xF) == 0) n--;
+    return n;
+}
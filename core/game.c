@@ -1,21 +1,84 @@
 // Portable game logic for Snake - works on all platforms
 #include "game.h"
+#include "sfx.h"
 #include <string.h>
 
+// Whole Game must stay well inside the 32 KB of GBA IWRAM (shared with stack and IWRAM code)
+_Static_assert(sizeof(Game) <= 8 * 1024, "Game no longer fits comfortably in IWRAM");
+
+// Movement speed per level in 16.16 cells per frame. Entries are given as
+// frames per step x10 so fractional paces are exact; level 1 keeps the
+// original 150 ms (9 frame) step.
+#define STEP_RATE(frames_x10) ((FIX_ONE * 10 + (frames_x10) / 2) / (frames_x10))
+static const uint32_t level_speed[] = {
+    STEP_RATE(90), STEP_RATE(80), STEP_RATE(72), STEP_RATE(64), STEP_RATE(56),
+    STEP_RATE(50), STEP_RATE(45), STEP_RATE(40), STEP_RATE(36), STEP_RATE(32)
+};
+#define LEVEL_COUNT (int)(sizeof(level_speed) / sizeof(level_speed[0]))
+
+// Speed for a level, capped at the last table entry
+uint32_t game_level_speed(int level) {
+    if (level < 1) level = 1;
+    if (level > LEVEL_COUNT) level = LEVEL_COUNT;
+    return level_speed[level - 1];
+}
+
+// Default hooks - the platform's sound and save memory
+static void plat_hook_sfx(void* ctx, uint8_t id) {
+    (void)ctx;
+    plat_sfx(id);
+}
+
+static int plat_hook_save_read(void* ctx, uint8_t* buf, int len) {
+    (void)ctx;
+    return plat_save_read(buf, len);
+}
+
+static void plat_hook_save_write(void* ctx, const uint8_t* buf, int len) {
+    (void)ctx;
+    plat_save_write(buf, len);
+}
+
+static const GameHooks plat_hooks = { plat_hook_sfx, plat_hook_save_read, plat_hook_save_write };
+static const GameHooks no_hooks = { NULL, NULL, NULL };
+
+static void game_sfx(Game* game, uint8_t id) {
+    if (game->hooks->sfx) game->hooks->sfx(game->hooks_ctx, id);
+}
+
 // Initialize game
 void game_init(Game* game) {
+    game_init_hooks(game, &plat_hooks, NULL);
+}
+
+void game_init_hooks(Game* game, const GameHooks* hooks, void* ctx) {
     memset(game, 0, sizeof(Game));
     
+    game->hooks = hooks ? hooks : &no_hooks;
+    game->hooks_ctx = ctx;
     game->gfx = plat_gfx_info();
     game->state = GAME_MENU;
+    game->drawn_state = DRAWN_NONE;
     game->snake_len = 3;
     game->dir_x = 1;
     game->dir_y = 0;
-    game->move_timer = 0;
+    game->move_accum = 0;
+    game->move_speed = game_level_speed(1);
+    rng_seed(&game->rng, 0);    // Callers normally pick the seed with game_seed
+    
+    // Stored high score and settings - a 16-byte read, done before the first frame
+    uint8_t rec[SAVE_SIZE];
+    int len = game->hooks->save_read ? game->hooks->save_read(ctx, rec, SAVE_SIZE) : 0;
+    save_decode(&game->saved, rec, len);
+    game->high_score = game->saved.high_score;
+    game->high_bcd = bcd_from_uint(game->high_score);
+    game->settings = game->saved.settings;
+    game->level = 1;
+    game->level_bcd = 1;
     
     // Initialize snake in center
-    int center_x = game->gfx.tiles_w / 2;
-    int center_y = game->gfx.tiles_h / 2;
+    int center_x = BOARD_W / 2;
+    int center_y = BOARD_H / 2;
     
     game->snake[0].x = center_x;
     game->snake[0].y = center_y;
@@ -29,87 +92,181 @@ void game_init(Game* game) {
     game->food.y = center_y;
 }
 
-// Spawn food at random location - BULLETPROOF VERSION
+// Free-cell set: every board cell not covered by the snake, kept dense so
+// spawning food is a single random pick instead of a board scan
+static void game_free_cells_reset(Game* game) {
+    for (int c = 0; c < BOARD_CELLS; c++) {
+        game->free_cells[c] = c;
+        game->free_index[c] = c;
+    }
+    game->free_count = BOARD_CELLS;
+}
+
+// Remove a cell from the free set (swap-remove)
+static void game_cell_occupy(Game* game, int cell) {
+    int pos = game->free_index[cell];
+    int last = game->free_cells[game->free_count - 1];
+    
+    game->free_cells[pos] = last;
+    game->free_index[last] = pos;
+    game->free_cells[game->free_count - 1] = cell;
+    game->free_index[cell] = game->free_count - 1;
+    game->free_count--;
+}
+
+// Return a cell to the free set
+static void game_cell_release(Game* game, int cell) {
+    int pos = game->free_index[cell];
+    int first = game->free_cells[game->free_count];
+    
+    game->free_cells[pos] = first;
+    game->free_index[first] = pos;
+    game->free_cells[game->free_count] = cell;
+    game->free_index[cell] = game->free_count;
+    game->free_count++;
+}
+
+void game_seed(Game* game, uint32_t seed) {
+    rng_seed(&game->rng, seed);
+}
+
+// Write the high score and settings back once they change. Writes wait until
+// the game is not being played, so save memory is never touched mid-run and
+// a run that beats the record several times costs one write.
+void game_save(Game* game) {
+    if (game->state == GAME_PLAYING) return;
+    if (game->high_score == game->saved.high_score &&
+        game->settings == game->saved.settings) return;
+    
+    game->saved.high_score = game->high_score;
+    game->saved.settings = game->settings;
+    if (game->hooks->save_write) {
+        uint8_t rec[SAVE_SIZE];
+        save_encode(&game->saved, rec);
+        game->hooks->save_write(game->hooks_ctx, rec, SAVE_SIZE);
+    }
+}
+
+// Spawn food on a uniformly random free cell - O(1)
 void game_spawn_food(Game* game) {
-    // Create a simple position that's guaranteed to work
-    // Start from top-left and find first empty spot
-    for (int fy = 0; fy < game->gfx.tiles_h; fy++) {
-        for (int fx = 0; fx < game->gfx.tiles_w; fx++) {
-            // Check if this position is empty
-            int occupied = 0;
-            for (int i = 0; i < game->snake_len; i++) {
-                if (game->snake[i].x == fx && game->snake[i].y == fy) {
-                    occupied = 1;
-                    break;
-                }
-            }
-            
-            if (!occupied) {
-                game->food.x = fx;
-                game->food.y = fy;
-                return;
-            }
-        }
+    if (game->free_count == 0) {
+        // Snake covers the whole board
+        game->state = GAME_WON;
+        return;
     }
     
-    // If somehow all positions are occupied (shouldn't happen with 600 tiles),
-    // place food at a position that's definitely not the head
-    game->food.x = (game->snake[0].x + 1) % game->gfx.tiles_w;
-    game->food.y = (game->snake[0].y + 1) % game->gfx.tiles_h;
+    int cell = game->free_cells[rng_range(&game->rng, game->free_count)];
+    game->food.x = cell % BOARD_W;
+    game->food.y = cell / BOARD_W;
+}
+
+// Queue newly pressed directions; they are applied one per movement tick
+// so quick double turns survive instead of overwriting each other
+static void game_queue_turns(Game* game, uint32_t pressed) {
+    static const uint8_t order[4] = { BTN_UP, BTN_DOWN, BTN_LEFT, BTN_RIGHT };
+    
+    for (int i = 0; i < 4; i++) {
+        if (!(pressed & order[i])) continue;
+        if (game->turn_count == TURN_QUEUE_LEN) return; // Full - drop the newest
+        
+        int slot = (game->turn_head + game->turn_count) & (TURN_QUEUE_LEN - 1);
+        game->turn_queue[slot] = order[i];
+        game->turn_stamps[slot] = game->input_stamp;
+        game->turn_count++;
+    }
+}
+
+// Apply the first queued turn that is valid from the current direction;
+// reversals and no-op turns are discarded
+static void game_apply_turn(Game* game) {
+    while (game->turn_count) {
+        uint8_t btn = game->turn_queue[game->turn_head];
+        uint32_t stamp = game->turn_stamps[game->turn_head];
+        game->turn_head = (game->turn_head + 1) & (TURN_QUEUE_LEN - 1);
+        game->turn_count--;
+        
+        int dx = (btn == BTN_RIGHT) - (btn == BTN_LEFT);
+        int dy = (btn == BTN_DOWN) - (btn == BTN_UP);
+        if (dx == -game->dir_x && dy == -game->dir_y) continue;
+        if (dx == game->dir_x && dy == game->dir_y) continue;
+        
+        game->dir_x = dx;
+        game->dir_y = dy;
+        game->turn_applied = 1;
+        game->turn_applied_stamp = stamp;
+        return;
+    }
+}
+
+// Autopilot game from the menu - scored, but never a new high score
+static void game_start_demo(Game* game) {
+    game_reset(game);
+    game->demo = 1;
+    game_sfx(game, SFX_START);
+}
+
+// Back to the menu from wherever the demo got to (playing, over or won)
+static void game_end_demo(Game* game) {
+    game->demo = 0;
+    game->state = GAME_MENU;
 }
 
 // Update game state
 void game_update(Game* game, uint32_t buttons) {
     game->frame_count++;
+    game->turn_applied = 0;
+    
+    // Edge detection - platforms report held keys, only new presses act
+    uint32_t pressed = buttons & ~game->buttons_held;
+    game->buttons_held = buttons;
+    game->buttons_pressed = pressed;
+    
+    // Attract demo - game->demo doubles as the held state of GAME_INPUT_DEMO
+    if ((buttons & GAME_INPUT_DEMO) && !game->demo) {
+        if (game->state == GAME_MENU) game_start_demo(game);
+    } else if (!(buttons & GAME_INPUT_DEMO) && game->demo) {
+        game_end_demo(game);
+        return;
+    }
     
     // Handle input based on game state
-    if (buttons & BTN_START) {
-        if (game->state == GAME_MENU || game->state == GAME_OVER) {
+    if (pressed & BTN_START) {
+        if (game->state == GAME_MENU || game->state == GAME_OVER || game->state == GAME_WON) {
             game_reset(game);
+            game_sfx(game, SFX_START);
         } else if (game->state == GAME_PLAYING) {
             game->state = GAME_PAUSED;
+            game_sfx(game, SFX_PAUSE);
         } else if (game->state == GAME_PAUSED) {
             game->state = GAME_PLAYING;
+            game_sfx(game, SFX_PAUSE);
         }
     }
     
     if (game->state != GAME_PLAYING) return;
     
     // Handle movement input
-    if (buttons & BTN_UP && game->dir_y != 1) {
-        game->dir_x = 0; game->dir_y = -1;
-    } else if (buttons & BTN_DOWN && game->dir_y != -1) {
-        game->dir_x = 0; game->dir_y = 1;
-    } else if (buttons & BTN_LEFT && game->dir_x != 1) {
-        game->dir_x = -1; game->dir_y = 0;
-    } else if (buttons & BTN_RIGHT && game->dir_x != -1) {
-        game->dir_x = 1; game->dir_y = 0;
-    }
+    game_queue_turns(game, pressed);
+    
+    // Movement timing - fixed-point accumulator, step once per whole cell
+    game->move_accum += game->move_speed;
+    if (game->move_accum < FIX_ONE) return;
+    game->move_accum -= FIX_ONE;
     
-    // Movement timing (fixed timestep)
-    game->move_timer++;
-    int move_frames = 60 * TICK_MS / 1000; // Convert ms to frames at 60fps
-    if (game->move_timer < move_frames) return;
-    game->move_timer = 0;
+    game_apply_turn(game);
     
     // Calculate new head position
-    int nx = game->snake[0].x + game->dir_x;
-    int ny = game->snake[0].y + game->dir_y;
+    Cell head = game->snake[game->snake_head];
     
     // Wall wrapping
-    if (nx < 0) nx = game->gfx.tiles_w - 1;
-    if (ny < 0) ny = game->gfx.tiles_h - 1;
-    if (nx >= game->gfx.tiles_w) nx = 0;
-    if (ny >= game->gfx.tiles_h) ny = 0;
+    int nx = board_wrap_x(head.x + game->dir_x);
+    int ny = board_wrap_y(head.y + game->dir_y);
     
     // Check collision
-    if (game->grid[ny][nx] == 1) {
+    if (game_grid_test(game, nx, ny)) {
         // Game over
         game->state = GAME_OVER;
-        if (game->score > game->high_score) {
-            game->high_score = game->score;
-        }
-        plat_beep_hit();
+        game_sfx(game, SFX_HIT);
         return;
     }
     
@@ -119,47 +276,75 @@ void game_update(Game* game, uint32_t buttons) {
         ate_food = 1;
     }
     
-    // Move snake
-    for (int i = game->snake_len - 1; i > 0; i--) {
-        game->snake[i] = game->snake[i - 1];
+    // Keep the free-cell set and grid in step: new head is taken, old tail
+    // is vacated unless the snake grows into it
+    Cell tail = game->snake[game_snake_tail(game)];
+    int grow = ate_food && game->snake_len < MAX_SNAKE_LEN;
+    game_cell_occupy(game, board_cell(nx, ny));
+    if (!grow) {
+        game_cell_release(game, board_cell(tail.x, tail.y));
+        game_grid_clear(game, tail.x, tail.y);
     }
-    game->snake[0].x = nx;
-    game->snake[0].y = ny;
+    game_grid_set(game, nx, ny);
+    
+    // Move snake - push the new head in front; the old tail slot drops off
+    // the end of the ring unless the snake grows
+    game->snake_head = game->snake_head ? game->snake_head - 1 : MAX_SNAKE_LEN - 1;
+    game->snake[game->snake_head].x = nx;
+    game->snake[game->snake_head].y = ny;
     
     // If we ate food, grow snake and spawn new food
     if (ate_food) {
-        // Grow snake
-        if (game->snake_len < MAX_SNAKE_LEN) {
+        // Grow snake - the old tail stays put as the new last segment
+        if (grow) {
             game->snake_len++;
-            game->snake[game->snake_len - 1] = game->snake[game->snake_len - 2];
         }
         
-        // Update score
-        game->score += 10;
-        if (game->score > game->high_score) {
+        // Update score - binary for comparisons and saves, BCD for the HUD
+        game->score += FOOD_POINTS;
+        game->score_bcd = bcd_add(game->score_bcd, 0x10);
+        if (game->score > game->high_score && !game->demo) {
             game->high_score = game->score;
+            game->high_bcd = game->score_bcd;
         }
         
-        // Level up every 5 food
-        game->level = (game->score / 50) + 1;
+        // Level up every FOOD_PER_LEVEL food
+        int leveled = ++game->level_food == FOOD_PER_LEVEL;
+        if (leveled) {
+            game->level_food = 0;
+            game->level++;
+            game->level_bcd = bcd_add(game->level_bcd, 1);
+            game->move_speed = game_level_speed(game->level);
+        }
         
         // Spawn new food IMMEDIATELY after growing snake
         game_spawn_food(game);
         
-        plat_beep_ok();
-    }
-    
-    // Update grid with new snake positions (for collision detection)
-    memset(game->grid, 0, sizeof(game->grid));
-    for (int i = 0; i < game->snake_len; i++) {
-        game->grid[game->snake[i].y][game->snake[i].x] = 1;
+        if (leveled) {
+            game_sfx(game, SFX_LEVEL_UP);
+        } else {
+            game_sfx(game, SFX_EAT);
+        }
     }
 }
 
 // Render game
 void game_render(Game* game) {
+    // Menu, pause and game-over screens only change with the state: once
+    // composed they stay in VRAM/the shadow map, so later frames skip the
+    // clear, the draw and the present entirely (the profiling overlay keeps
+    // changing, so it disables the cache while visible)
+    int overlay = game->profiler && game->profiler->visible;
+    if (game->state != GAME_PLAYING && !overlay) {
+        if (game->drawn_state == game->state) return;
+        game->drawn_state = game->state;
+    } else {
+        game->drawn_state = DRAWN_NONE;
+    }
+    
     // Clear screen
     plat_clear_bg();
+    game->sprite_count = 0;
     
     if (game->state == GAME_MENU) {
         // Draw menu
@@ -171,113 +356,148 @@ void game_render(Game* game) {
         if (game->state == GAME_PAUSED) {
             game_render_pause(game);
         }
-    } else if (game->state == GAME_OVER) {
+    } else if (game->state == GAME_OVER || game->state == GAME_WON) {
         // Draw game over
         game_render_game_over(game);
     }
     
+    // Profiling overlay on the bottom row
+    if (game->profiler && game->profiler->visible) {
+        profile_render_overlay(game->profiler, game->gfx.tiles_h - 1);
+    }
+    
+    // Hide sprites that were shown last frame but not this one
+    for (int id = game->sprite_count; id < game->sprite_prev; id++) {
+        plat_sprite_hide(id);
+    }
+    game->sprite_prev = game->sprite_count;
+    
     plat_present();
 }
 
+// Hand out the next hardware sprite for this frame, or -1 once the OAM
+// budget is spent (the plat_sprite_* calls ignore negative ids)
+int game_sprite_alloc(Game* game) {
+    if (game->sprite_count >= SPRITE_BUDGET) return -1;
+    return game->sprite_count++;
+}
+
+// Logo tiles 0-31, laid out as an 8x4 block
+static const uint16_t logo_tiles[8 * 4] = {
+     0,  1,  2,  3,  4,  5,  6,  7,
+     8,  9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23,
+    24, 25, 26, 27, 28, 29, 30, 31
+};
+
+// Draw a string as one tile run: digits and A-Z map to the font tiles,
+// anything else is left transparent
+void game_put_text(int tx, int ty, const char* str, uint8_t pal) {
+    uint16_t tiles[32];
+    int count = 0;
+    
+    for (; *str && count < 32; str++) {
+        char c = *str;
+        if (c >= '0' && c <= '9') {
+            tiles[count++] = FONT_TILE_DIGITS + (c - '0');
+        } else if (c >= 'A' && c <= 'Z') {
+            tiles[count++] = FONT_TILE_ALPHA + (c - 'A');
+        } else {
+            tiles[count++] = TILE_NONE;
+        }
+    }
+    plat_put_tile_run(tx, ty, tiles, count, pal);
+}
+
 // Render menu screen
 void game_render_menu(Game* game) {
     // Draw logo (8×4 tiles, centered)
     int logo_x = (game->gfx.tiles_w - 8) / 2;  // Center horizontally
     int logo_y = 6;  // Position from top
     
-    for (int y = 0; y < 4; y++) {
-        for (int x = 0; x < 8; x++) {
-            int tile_index = y * 8 + x;
-            plat_put_tile(logo_x + x, logo_y + y, tile_index, 0); // Logo tiles start at 0
-        }
-    }
+    plat_put_tile_rect(logo_x, logo_y, 8, 4, logo_tiles, 0); // Logo tiles start at 0
     
     // Draw "PRESS START" below logo
     int start_y = logo_y + 6;  // Below logo
     int start_x = (game->gfx.tiles_w - 11) / 2;  // Center "PRESS START"
     
-    plat_put_tile(start_x + 0, start_y, 32, 1);  // P
-    plat_put_tile(start_x + 1, start_y, 33, 1);  // R
-    plat_put_tile(start_x + 2, start_y, 34, 1);  // E
-    plat_put_tile(start_x + 3, start_y, 35, 1);  // S
-    plat_put_tile(start_x + 4, start_y, 35, 1);  // S
-    plat_put_tile(start_x + 6, start_y, 36, 1);  // START
-    plat_put_tile(start_x + 7, start_y, 37, 1);  // T
-    plat_put_tile(start_x + 8, start_y, 38, 1);  // A
-    plat_put_tile(start_x + 9, start_y, 39, 1);  // R
-    plat_put_tile(start_x + 10, start_y, 40, 1); // T
+    game_put_text(start_x, start_y, "PRESS START", 1);
 }
 
 // Render game screen
 void game_render_game(Game* game) {
-    // Draw snake using sprites
-    for (int i = 0; i < game->snake_len; i++) {
-        int px = game->snake[i].x * game->gfx.tile_px;
-        int py = game->snake[i].y * game->gfx.tile_px;
-        
-        uint16_t tile = (i == 0) ? 10 : 11; // Head or body tile
-        uint8_t pal = (i == 0) ? 2 : 3;     // Head or body palette
-        
-        plat_sprite_set(i, px, py, tile, pal);
+    // Draw snake head to tail: the head gets a hardware sprite, the body
+    // goes into the BG tilemap so its length never eats into the OAM budget
+    SnakeIter it = game_snake_iter(game);
+    const Cell* seg = game_snake_next(game, &it);
+    if (seg) {
+        // Slide the head from the cell it left (one step back along dir_*,
+        // where the neck is drawn) into its current cell by the fraction of
+        // the next step already accumulated, so it arrives as the next tick
+        // starts. Backends that snap sprites to cells just get the cell.
+        int tile = game->gfx.tile_px;
+        int lag = game->gfx.sprite_snap ? 0 : tile - ((game->move_accum * tile) >> FIX_SHIFT);
+        int px = seg->x * tile - game->dir_x * lag;
+        int py = seg->y * tile - game->dir_y * lag;
+        plat_sprite_set(game_sprite_alloc(game), px, py, 10, 2); // Head tile, white palette
     }
-    
-    // Hide unused sprites
-    for (int i = game->snake_len; i < MAX_SNAKE_LEN; i++) {
-        plat_sprite_hide(i);
+    while ((seg = game_snake_next(game, &it)) != NULL) {
+        plat_put_tile(seg->x, seg->y, 11, 3); // Body tile, green palette
     }
     
     // Draw food (only if coordinates are valid)
-    if (game->food.x >= 0 && game->food.x < game->gfx.tiles_w && 
-        game->food.y >= 0 && game->food.y < game->gfx.tiles_h) {
+    if (game->food.x < BOARD_W && game->food.y < BOARD_H) {
         int food_px = game->food.x * game->gfx.tile_px;
         int food_py = game->food.y * game->gfx.tile_px;
-        plat_sprite_set(MAX_SNAKE_LEN, food_px, food_py, 12, 1); // Food tile, red palette
-    } else {
-        // Hide food sprite if coordinates are invalid
-        plat_sprite_hide(MAX_SNAKE_LEN);
+        plat_sprite_set(game_sprite_alloc(game), food_px, food_py, 12, 1); // Food tile, red palette
     }
     
     // Draw score
     game_render_score(game);
 }
 
+// Put a packed BCD number as digit tiles into `tiles`, returns the digit count
+static int game_bcd_tiles(uint32_t bcd, uint16_t* tiles) {
+    int n = bcd_length(bcd);
+    for (int i = 0; i < n; i++) {
+        tiles[i] = FONT_TILE_DIGITS + ((bcd >> ((n - 1 - i) * 4)) & 0xF);
+    }
+    return n;
+}
+
 // Render score
 void game_render_score(Game* game) {
-    // Simple score display using tiles
-    int score = game->score;
-    int pos = 2; // Start position
-    
-    // Draw score digits
-    do {
-        int digit = score % 10;
-        plat_put_tile(pos, 0, 20 + digit, 0); // Score tiles start at 20
-        score /= 10;
-        pos--;
-    } while (score > 0 && pos >= 0);
+    // Top row: score at the left edge, "LV n" in the middle, "HI n" at the right edge
+    uint16_t tiles[3 + BCD_DIGITS];
+    int n = game_bcd_tiles(game->score_bcd, tiles);
+    plat_put_tile_run(0, 0, tiles, n, 0);
+    
+    tiles[0] = FONT_TILE_ALPHA + ('L' - 'A');
+    tiles[1] = FONT_TILE_ALPHA + ('V' - 'A');
+    tiles[2] = TILE_NONE;
+    n = 3 + game_bcd_tiles(game->level_bcd, tiles + 3);
+    plat_put_tile_run((game->gfx.tiles_w - n) / 2, 0, tiles, n, 0);
+    
+    tiles[0] = FONT_TILE_ALPHA + ('H' - 'A');
+    tiles[1] = FONT_TILE_ALPHA + ('I' - 'A');
+    n = 3 + game_bcd_tiles(game->high_bcd, tiles + 3);
+    plat_put_tile_run(game->gfx.tiles_w - n, 0, tiles, n, 0);
 }
 
 // Render pause screen
 void game_render_pause(Game* game) {
     // Draw "PAUSED" overlay
-    plat_put_tile(13, 8, 30, 2); // P
-    plat_put_tile(14, 8, 31, 2); // A
-    plat_put_tile(15, 8, 32, 2); // U
-    plat_put_tile(16, 8, 33, 2); // S
-    plat_put_tile(17, 8, 34, 2); // E
-    plat_put_tile(18, 8, 35, 2); // D
+    game_put_text(13, 8, "PAUSED", 2);
 }
 
 // Render game over screen
 void game_render_game_over(Game* game) {
-    // Draw "GAME OVER"
-    plat_put_tile(12, 8, 40, 2); // G
-    plat_put_tile(13, 8, 41, 2); // A
-    plat_put_tile(14, 8, 42, 2); // M
-    plat_put_tile(15, 8, 43, 2); // E
-    plat_put_tile(17, 8, 44, 2); // O
-    plat_put_tile(18, 8, 45, 2); // V
-    plat_put_tile(19, 8, 46, 2); // E
-    plat_put_tile(20, 8, 47, 2); // R
+    // Draw "GAME OVER", or "YOU WIN" once the snake has filled the board
+    if (game->state == GAME_WON) {
+        game_put_text(13, 8, "YOU WIN", 2);
+    } else {
+        game_put_text(12, 8, "GAME OVER", 2);
+    }
     
     // Draw final score
     game_render_score(game);
@@ -287,15 +507,22 @@ void game_render_game_over(Game* game) {
 void game_reset(Game* game) {
     game->state = GAME_PLAYING;
     game->score = 0;
+    game->score_bcd = 0;
     game->level = 1;
+    game->level_bcd = 1;
+    game->level_food = 0;
+    game->snake_head = 0;
     game->snake_len = 3;
     game->dir_x = 1;
     game->dir_y = 0;
-    game->move_timer = 0;
+    game->move_accum = 0;
+    game->move_speed = game_level_speed(1);
+    game->turn_head = 0;
+    game->turn_count = 0;
     
     // Reset snake position
-    int center_x = game->gfx.tiles_w / 2;
-    int center_y = game->gfx.tiles_h / 2;
+    int center_x = BOARD_W / 2;
+    int center_y = BOARD_H / 2;
     
     game->snake[0].x = center_x;
     game->snake[0].y = center_y;
@@ -304,6 +531,14 @@ void game_reset(Game* game) {
     game->snake[2].x = center_x - 2;
     game->snake[2].y = center_y;
     
+    // Rebuild collision grid and free-cell set around the new snake
+    memset(game->grid, 0, sizeof(game->grid));
+    game_free_cells_reset(game);
+    for (int i = 0; i < game->snake_len; i++) {
+        game_grid_set(game, game->snake[i].x, game->snake[i].y);
+        game_cell_occupy(game, board_cell(game->snake[i].x, game->snake[i].y));
+    }
+    
     // Initialize food position (simple placement)
     game->food.x = center_x + 3;
     game->food.y = center_y;
@@ -1,54 +1,231 @@
 // Portable game logic header for Snake
 #pragma once
+#include <stddef.h>
 #include "platform.h"
+#include "profile.h"
+#include "rng.h"
+#include "save.h"
+#include "bcd.h"
+
+// Board geometry - fixed per platform at compile time so the grid is sized
+// exactly and the hot paths see constants (must match plat_gfx_info)
+#ifndef BOARD_W
+#if defined(ARM9) || defined(HOST_NDS)
+#define BOARD_W 32               // NDS: 256x192
+#define BOARD_H 24
+#else
+#define BOARD_W 30               // GBA: 240x160
+#define BOARD_H 20
+#endif
+#endif
+#define BOARD_CELLS (BOARD_W * BOARD_H)
+#define BOARD_W_POW2 ((BOARD_W & (BOARD_W - 1)) == 0)
+#define BOARD_H_POW2 ((BOARD_H & (BOARD_H - 1)) == 0)
+
+_Static_assert(BOARD_W <= 32, "Each grid row is one uint32_t bitboard word");
+_Static_assert(BOARD_W <= 256 && BOARD_H <= 256, "Cell coordinates are bytes");
+_Static_assert(BOARD_CELLS <= 65535, "Free-cell indices are uint16_t");
 
 // Game constants
-#define MAX_SNAKE_LEN (30 * 20)  // Max grid size
-#define TICK_MS 150              // Movement speed in milliseconds
+#define MAX_SNAKE_LEN BOARD_CELLS  // The snake can cover the whole board
+#define FIX_SHIFT 16             // Movement uses 16.16 fixed point, no floats on ARM7TDMI
+#define FIX_ONE (1 << FIX_SHIFT)
+#define SPRITE_BUDGET 128        // Hardware OAM entries on GBA and NDS
+#define TURN_QUEUE_LEN 4         // Buffered direction presses (power of two)
+#define FOOD_POINTS 10           // Score per food
+#define FOOD_PER_LEVEL 5         // Food eaten between level ups
+
+// Tile layout: logo 0-31 (8x4), snake head/body/food 10-12 (OBJ), digits 20-29,
+// letters A-Z 48-73
+#define FONT_TILE_DIGITS 20
+#define FONT_TILE_ALPHA 48
 
 // Game state
 typedef enum {
     GAME_MENU,
     GAME_PLAYING,
     GAME_PAUSED,
-    GAME_OVER
+    GAME_OVER,
+    GAME_WON        // Board full - nowhere left to put food
 } GameState;
 
-// Game data structure - using GBA fast RAM
+#define DRAWN_NONE 0xFF   // No static screen cached (see Game::drawn_state)
+
+// Not a key: held in the buttons passed to game_update while the attract
+// autopilot plays (core/attract.h). Raising it on the menu starts a demo
+// game and dropping it ends the demo back on the menu, so the demo goes
+// through game_update and replays like any other input.
+#define GAME_INPUT_DEMO (1u << 8)
+
+// Packed board cell - coordinates fit in a byte on every target
+typedef struct {
+    uint8_t x, y;
+} Cell;
+
+// Side effects of the core, one set per Game. game_init installs the
+// platform's (plat_sfx, plat_save_read/write); game_init_hooks lets headless
+// tools give every instance its own, or none - a NULL entry is a no-op.
+// ctx is passed back untouched.
+typedef struct {
+    void (*sfx)(void* ctx, uint8_t id);                         // SfxId from sfx.h
+    int (*save_read)(void* ctx, uint8_t* buf, int len);         // Bytes read, 0 if nothing is stored
+    void (*save_write)(void* ctx, const uint8_t* buf, int len);
+} GameHooks;
+
+// Game data structure - packed small enough to live in GBA IWRAM
 typedef struct {
-    // Snake data (in EWRAM for speed)
-    Vec2 snake[MAX_SNAKE_LEN];
-    int snake_len;
-    int dir_x, dir_y;
+    // Game state
+    uint8_t state;          // GameState
+    int8_t dir_x, dir_y;
+    uint16_t level;
     
-    // Food
-    Vec2 food;
+    // Input - held mask from last frame, new presses this frame, and the
+    // direction presses waiting for the next movement tick
+    uint8_t buttons_held;
+    uint8_t buttons_pressed;
+    uint8_t turn_queue[TURN_QUEUE_LEN];
+    uint8_t turn_head;
+    uint8_t turn_count;
+    uint8_t turn_applied;                   // A queued turn took effect this update
+    uint32_t input_stamp;                   // Set by the caller: when this update's buttons were latched
+    uint32_t turn_stamps[TURN_QUEUE_LEN];   // input_stamp of each queued turn
+    uint32_t turn_applied_stamp;            // input_stamp of the turn applied this update
     
-    // Game state
-    GameState state;
-    int score;
-    int high_score;
-    int level;
+    // Snake data - ring buffer, segment i lives at snake[(snake_head + i) % MAX_SNAKE_LEN]
+    uint16_t snake_head;
+    uint16_t snake_len;
+    
+    // Food - placed with the game's own generator (seed with game_seed)
+    Cell food;
+    Rng rng;
+    
+    int32_t score;
+    int32_t high_score;
     
-    // Grid for collision detection (optimized size)
-    uint8_t grid[20][30]; // 0=empty, 1=snake, 2=food
+    // Displayed counters in packed BCD, kept in step with score/high_score/level
+    // so the HUD never divides
+    uint32_t score_bcd;
+    uint32_t high_bcd;
+    uint16_t level_bcd;
+    uint8_t level_food;     // Food eaten since the last level up
+    uint8_t demo;           // Autopilot attract mode - does not touch the high score
     
-    // Timing
-    int frame_count;
-    int move_timer;
+    // Persistent settings (SETTING_*) and the record last loaded/stored -
+    // game_save writes only when these differ from it
+    uint8_t settings;
+    SaveData saved;
+    
+    // Timing - move_accum gains level_speed[level] (cells/frame, 16.16) each
+    // frame and the snake steps whenever it passes one whole cell
+    uint32_t frame_count;
+    uint32_t move_accum;
+    uint32_t move_speed;
     
     // Graphics info
     GfxInfo gfx;
+    
+    // Sound and save memory for this instance (see GameHooks)
+    const GameHooks* hooks;
+    void* hooks_ctx;
+    
+    // Frame-time overlay source, drawn by game_render when visible (may be NULL)
+    const Profiler* profiler;
+    
+    // Static screen currently on display (menu/pause/game over), or DRAWN_NONE
+    uint8_t drawn_state;
+    
+    // Hardware sprites handed out this frame / last frame (see game_sprite_alloc)
+    uint8_t sprite_count;
+    uint8_t sprite_prev;
+    
+    // Occupancy bitboard for collision detection - bit x of grid[y] is set under the snake
+    uint32_t grid[BOARD_H];
+    
+    // Free-cell set for O(1) food spawning (cell = y * BOARD_W + x)
+    uint16_t free_count;
+    uint16_t free_cells[MAX_SNAKE_LEN]; // Dense array of cells not under the snake
+    uint16_t free_index[MAX_SNAKE_LEN]; // Position of each cell in free_cells
+    
+    Cell snake[MAX_SNAKE_LEN];
 } Game;
 
+_Static_assert(MAX_SNAKE_LEN == BOARD_CELLS, "Snake ring and free-cell set must cover the board exactly");
+
+// Step a coordinate one cell off the edge back onto the board - a mask when
+// the dimension is a power of two, otherwise a compare
+static inline int board_wrap_x(int x) {
+#if BOARD_W_POW2
+    return x & (BOARD_W - 1);
+#else
+    return x < 0 ? BOARD_W - 1 : (x >= BOARD_W ? 0 : x);
+#endif
+}
+
+static inline int board_wrap_y(int y) {
+#if BOARD_H_POW2
+    return y & (BOARD_H - 1);
+#else
+    return y < 0 ? BOARD_H - 1 : (y >= BOARD_H ? 0 : y);
+#endif
+}
+
+static inline int board_cell(int x, int y) {
+    return y * BOARD_W + x;
+}
+
+// Occupancy bitboard access
+static inline int game_grid_test(const Game* game, int x, int y) {
+    return (game->grid[y] >> x) & 1;
+}
+
+static inline void game_grid_set(Game* game, int x, int y) {
+    game->grid[y] |= 1u << x;
+}
+
+static inline void game_grid_clear(Game* game, int x, int y) {
+    game->grid[y] &= ~(1u << x);
+}
+
+// Head-to-tail walk over the snake ring buffer
+typedef struct {
+    int index;
+    int remaining;
+} SnakeIter;
+
+static inline SnakeIter game_snake_iter(const Game* game) {
+    SnakeIter it = { game->snake_head, game->snake_len };
+    return it;
+}
+
+// Returns the next segment, or NULL once the tail has been passed
+static inline const Cell* game_snake_next(const Game* game, SnakeIter* it) {
+    if (it->remaining == 0) return NULL;
+    const Cell* seg = &game->snake[it->index];
+    if (++it->index == MAX_SNAKE_LEN) it->index = 0;
+    it->remaining--;
+    return seg;
+}
+
+// Ring index of the last segment
+static inline int game_snake_tail(const Game* game) {
+    int tail = game->snake_head + game->snake_len - 1;
+    return tail >= MAX_SNAKE_LEN ? tail - MAX_SNAKE_LEN : tail;
+}
+
 // Game functions
 void game_init(Game* game);
+void game_init_hooks(Game* game, const GameHooks* hooks, void* ctx); // hooks may be NULL: silent, nothing saved
+void game_seed(Game* game, uint32_t seed);  // Food placement sequence (stored in replays)
+void game_save(Game* game);                 // Persist high score/settings if changed (skipped while playing)
 void game_update(Game* game, uint32_t buttons);
 void game_render(Game* game);
 void game_reset(Game* game);
 void game_spawn_food(Game* game);
+uint32_t game_level_speed(int level);       // Movement speed (16.16 cells/frame) for a level
 void game_render_menu(Game* game);
 void game_render_game(Game* game);
 void game_render_pause(Game* game);
 void game_render_game_over(Game* game);
 void game_render_score(Game* game);
+void game_put_text(int tx, int ty, const char* str, uint8_t pal);
+int game_sprite_alloc(Game* game);
@@ -0,0 +1,125 @@
+// Fixed-point software mixer - per-channel accumulate, then one clip pass
+#include "mixer.h"
+#include <string.h>
+
+// The GBA runs the mixing loops as ARM code from IWRAM; elsewhere they are plain functions
+#ifdef PLATFORM_GBA
+#define MIX_HOT __attribute__((section(".iwram"), long_call, target("arm"), noinline))
+#else
+#define MIX_HOT
+#endif
+
+void mixer_init(Mixer* mixer) {
+    memset(mixer, 0, sizeof(Mixer));
+}
+
+int mixer_play(Mixer* mixer, const MixVoice* voice) {
+    // Prefer an idle channel, otherwise the one with the least left to play
+    int best = 0;
+    for (int i = 0; i < MIX_CHANNELS; i++) {
+        MixChannel* ch = &mixer->channels[i];
+        if (!ch->data) {
+            best = i;
+            break;
+        }
+        if (ch->remaining < mixer->channels[best].remaining) best = i;
+    }
+
+    const MixSound* sound = voice->sound;
+    MixChannel* ch = &mixer->channels[best];
+    ch->data = sound->data;
+    ch->pos = 0;
+    ch->end = sound->length << MIX_FRAC;
+    ch->step = voice->step;
+    ch->slide = voice->slide;
+    ch->volume = voice->volume > MIX_VOLUME_MAX ? MIX_VOLUME_MAX : voice->volume;
+    ch->decay = voice->decay;
+    ch->loop = sound->loop;
+
+    ch->remaining = voice->duration ? voice->duration : UINT32_MAX;
+    if (ch->step == 0) ch->data = NULL;
+    return best;
+}
+
+void mixer_stop(Mixer* mixer, int channel) {
+    if (channel < 0 || channel >= MIX_CHANNELS) return;
+    mixer->channels[channel].data = NULL;
+}
+
+int mixer_active(const Mixer* mixer) {
+    int n = 0;
+    for (int i = 0; i < MIX_CHANNELS; i++) {
+        if (mixer->channels[i].data) n++;
+    }
+    return n;
+}
+
+// Add up to `count` samples of one channel into the accumulator
+MIX_HOT static void mix_channel(MixChannel* ch, int16_t* accum, int count) {
+    const int8_t* data = ch->data;
+    uint32_t pos = ch->pos;
+    uint32_t step = ch->step;
+    uint32_t end = ch->end;
+    int vol = ch->volume;
+
+    int n = ch->remaining < (uint32_t)count ? (int)ch->remaining : count;
+    if (ch->loop) {
+        for (int i = 0; i < n; i++) {
+            accum[i] += data[pos >> MIX_FRAC] * vol;
+            pos += step;
+            if (pos >= end) pos -= end;
+        }
+    } else {
+        // Stop on the last sample of a one-shot sound; the end compare
+        // replaces the wrap, so no division clamps the run up front
+        for (int i = 0; i < n; i++) {
+            accum[i] += data[pos >> MIX_FRAC] * vol;
+            pos += step;
+            if (pos >= end) {
+                n = i + 1;
+                ch->remaining = n;
+                break;
+            }
+        }
+    }
+    ch->pos = pos;
+    ch->remaining -= n;
+
+    // Envelope and pitch sweep advance once per mixed block
+    int nextVol = vol - ch->decay;
+    int32_t nextStep = (int32_t)step + ch->slide;
+    if (ch->remaining == 0 || nextVol <= 0 || nextStep <= 0) {
+        ch->data = NULL;
+        return;
+    }
+    ch->volume = (uint8_t)nextVol;
+    ch->step = (uint32_t)nextStep;
+}
+
+MIX_HOT void mixer_mix(Mixer* mixer, int8_t* out, int count) {
+    while (count > 0) {
+        int block = count < MIX_FRAME_SAMPLES ? count : MIX_FRAME_SAMPLES;
+        int live = 0;
+
+        memset(mixer->accum, 0, block * sizeof(int16_t));
+        for (int c = 0; c < MIX_CHANNELS; c++) {
+            MixChannel* ch = &mixer->channels[c];
+            if (!ch->data) continue;
+            mix_channel(ch, mixer->accum, block);
+            live = 1;
+        }
+
+        if (!live) {
+            memset(out, 0, block);
+        } else {
+            // Volume 64 is unity gain; clip the sum back to 8 bits
+            for (int i = 0; i < block; i++) {
+                int s = mixer->accum[i] >> 6;
+                out[i] = s > 127 ? 127 : (s < -128 ? -128 : s);
+            }
+        }
+
+        out += block;
+        count -= block;
+    }
+}
@@ -0,0 +1,62 @@
+// Fixed-point software mixer for Snake
+// A few channels of signed 8-bit PCM are resampled with a 20.12 position
+// step, scaled by a 0..64 volume and summed into a signed 8-bit output
+// block. Nothing here touches hardware: the platform calls mixer_mix once
+// per frame and hands the block to its sound output (GBA: timer 0 + DMA1
+// into FIFO A, host: a WAV file).
+#pragma once
+#include <stdint.h>
+
+#define MIX_CHANNELS 4
+#define MIX_RATE 13379          // Hz - 1254 GBA cycles per sample
+#define MIX_FRAME_SAMPLES 224   // Output samples per 59.73 Hz video frame (exact)
+#define MIX_FRAC 12             // Fraction bits of channel position and step
+#define MIX_VOLUME_MAX 64
+
+// Step that plays a cycle of `len` samples at `freq` Hz
+#define MIX_STEP(freq, len) ((uint32_t)(((uint64_t)(freq) * (len) << MIX_FRAC) / MIX_RATE))
+
+// Signed 8-bit PCM
+typedef struct {
+    const int8_t* data;
+    uint32_t length;        // Samples
+    uint8_t loop;           // Wrap to the start instead of stopping at the end
+} MixSound;
+
+// One playback of a sound: pitch, envelope and duration
+typedef struct {
+    const MixSound* sound;
+    uint32_t step;          // 20.12 source samples per output sample
+    int32_t slide;          // Added to step every mixed frame (pitch sweep)
+    uint32_t duration;      // Output samples to play (0 = until the sound ends, or until stopped if it loops)
+    uint8_t volume;         // 0..MIX_VOLUME_MAX
+    uint8_t decay;          // Volume lost every mixed frame
+} MixVoice;
+
+typedef struct {
+    const int8_t* data;     // NULL = idle
+    uint32_t pos;           // 20.12 position in data
+    uint32_t end;           // length << MIX_FRAC
+    uint32_t step;
+    int32_t slide;
+    uint32_t remaining;     // Output samples left
+    uint8_t volume;
+    uint8_t decay;
+    uint8_t loop;
+} MixChannel;
+
+typedef struct {
+    MixChannel channels[MIX_CHANNELS];
+    int16_t accum[MIX_FRAME_SAMPLES];   // Sum of all channels before clipping
+} Mixer;
+
+void mixer_init(Mixer* mixer);
+
+// Start a voice on an idle channel, or steal the one closest to finishing.
+// Returns the channel used.
+int mixer_play(Mixer* mixer, const MixVoice* voice);
+void mixer_stop(Mixer* mixer, int channel);
+int mixer_active(const Mixer* mixer);   // Channels currently playing
+
+// Mix `count` output samples into `out` and advance every channel
+void mixer_mix(Mixer* mixer, int8_t* out, int count);
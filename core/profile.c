@@ -0,0 +1,92 @@
+// Frame-time instrumentation - per-phase tick ring buffer and overlay
+#include "profile.h"
+#include "platform.h"
+#include "game.h"
+#include "bcd.h"
+#include <string.h>
+
+void profile_init(Profiler* prof) {
+    memset(prof, 0, sizeof(Profiler));
+    prof->budget = plat_cycles_per_frame();
+
+    // Ticks to percent by multiply-high, so the overlay does no division
+    uint32_t percent_div = prof->budget / 100;
+    prof->percent_mul = percent_div > 1 ? 0xFFFFFFFFu / percent_div + 1 : 0xFFFFFFFFu;
+}
+
+void profile_record(Profiler* prof, uint32_t update, uint32_t render, uint32_t mix) {
+    prof->samples[prof->head][PROF_UPDATE] = update;
+    prof->samples[prof->head][PROF_RENDER] = render;
+    prof->samples[prof->head][PROF_MIX] = mix;
+    prof->head = (prof->head + 1) & (PROFILE_FRAMES - 1);
+    if (prof->count < PROFILE_FRAMES) prof->count++;
+    prof->frames++;
+
+    if (update + render + mix > prof->budget) {
+        prof->vblank_misses++;
+    }
+}
+
+void profile_latency(Profiler* prof, uint32_t frames) {
+    if (frames > 0xFF) frames = 0xFF;
+    uint8_t* slot = &prof->latency[prof->latency_count & (LATENCY_WINDOW - 1)];
+    prof->latency_sum += frames - *slot;
+    *slot = (uint8_t)frames;
+    prof->latency_count++;
+    if (frames > prof->latency_max) prof->latency_max = frames;
+}
+
+ProfileStats profile_stats(const Profiler* prof, ProfilePhase phase) {
+    ProfileStats st = { 0, 0, 0 };
+    if (prof->count == 0) return st;
+
+    uint32_t sum = 0;
+    st.min = 0xFFFFFFFF;
+    for (int i = 0; i < prof->count; i++) {
+        uint32_t t = prof->samples[i][phase];
+        if (t < st.min) st.min = t;
+        if (t > st.max) st.max = t;
+        sum += t;
+    }
+    st.avg = (prof->count == PROFILE_FRAMES) ? sum / PROFILE_FRAMES : sum / prof->count;
+    return st;
+}
+
+// Right-aligned number, `width` digit tiles ending at column x + width - 1.
+// Converted to BCD like the HUD counters - no libgcc division per digit
+static void draw_number(int x, int y, uint32_t value, int width) {
+    uint16_t digits[BCD_DIGITS];
+    uint32_t bcd = bcd_from_uint(value);
+    int n = bcd_length(bcd);
+    if (n > width) n = width;   // Too wide: keep the low digits
+
+    for (int i = 0; i < n; i++) {
+        digits[i] = FONT_TILE_DIGITS + ((bcd >> ((n - 1 - i) * 4)) & 0xF);
+    }
+    plat_put_tile_run(x + width - n, y, digits, n, 0);
+}
+
+static uint32_t percent(const Profiler* prof, uint32_t ticks) {
+    return (uint32_t)(((uint64_t)ticks * prof->percent_mul) >> 32);
+}
+
+void profile_render_overlay(const Profiler* prof, int row) {
+    for (int phase = 0; phase < PROF_PHASES; phase++) {
+        ProfileStats st = profile_stats(prof, phase);
+        int x = phase == PROF_MIX ? 12 : phase * 12;
+        int y = phase == PROF_MIX ? row - 1 : row;
+
+        draw_number(x + 0, y, percent(prof, st.min), 3);
+        draw_number(x + 4, y, percent(prof, st.avg), 3);
+        draw_number(x + 8, y, percent(prof, st.max), 3);
+    }
+    draw_number(25, row, prof->vblank_misses, 4);
+
+    // The average waits for a full window, so it stays a shift
+    if (prof->latency_count >= LATENCY_WINDOW) {
+        draw_number(0, row - 1, prof->latency_sum >> LATENCY_SHIFT, 3);
+    }
+    if (prof->latency_count) {
+        draw_number(4, row - 1, prof->latency_max, 3);
+    }
+}
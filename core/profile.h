@@ -0,0 +1,48 @@
+// Frame-time instrumentation for Snake
+// main.c samples plat_cycles() around plat_audio / game_update / game_render
+// every frame;
+// the last PROFILE_FRAMES samples are kept in a ring buffer and summarized
+// as min/avg/max, optionally drawn as a one-row overlay (toggle: SELECT).
+#pragma once
+#include <stdint.h>
+
+#define PROFILE_FRAMES 64   // Power of two - the average is a shift
+#define LATENCY_SHIFT  4
+#define LATENCY_WINDOW (1 << LATENCY_SHIFT) // Turns averaged for the latency figure
+
+typedef enum {
+    PROF_UPDATE,
+    PROF_RENDER,
+    PROF_MIX,
+    PROF_PHASES
+} ProfilePhase;
+
+typedef struct {
+    uint32_t min, avg, max;
+} ProfileStats;
+
+typedef struct Profiler {
+    uint32_t samples[PROFILE_FRAMES][PROF_PHASES]; // Ticks per phase, ring buffer
+    int head;                   // Next slot to write
+    int count;                  // Valid samples (<= PROFILE_FRAMES)
+    uint32_t frames;            // Frames recorded in total
+    uint32_t vblank_misses;     // Frames whose work overran one frame budget
+    uint8_t latency[LATENCY_WINDOW]; // Input latency: VBlanks from key latch to turn applied
+    uint32_t latency_sum;       // Sum over the window
+    uint32_t latency_max;
+    uint32_t latency_count;
+    uint32_t budget;            // plat_cycles ticks per frame
+    uint32_t percent_mul;       // 2^32 / (budget / 100), for the overlay
+    uint8_t visible;            // Overlay shown
+} Profiler;
+
+void profile_init(Profiler* prof);
+void profile_record(Profiler* prof, uint32_t update, uint32_t render, uint32_t mix);
+void profile_latency(Profiler* prof, uint32_t frames);
+ProfileStats profile_stats(const Profiler* prof, ProfilePhase phase);
+
+// Draw "update min avg max | render min avg max | misses" as percentages of
+// a frame on tile row `row`, and "latency avg max | mix min avg max" on the
+// row above (latency in frames, the average over the last LATENCY_WINDOW
+// turns; mix as percentages, under render), using the score digit tiles
+void profile_render_overlay(const Profiler* prof, int row);
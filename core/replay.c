@@ -0,0 +1,127 @@
+// Deterministic input replays - run-length encoded Buttons streams
+#include "replay.h"
+#include <string.h>
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void write_header(Replay* rp) {
+    memcpy(rp->out, "SNKR", 4);
+    rp->out[4] = REPLAY_VERSION;
+    rp->out[5] = rp->gfx.tiles_w;
+    rp->out[6] = rp->gfx.tiles_h;
+    rp->out[7] = rp->gfx.tile_px;
+    put_u32(rp->out + 8, rp->seed);
+    put_u32(rp->out + 12, rp->frames);
+}
+
+// Append the pending run; returns 0 if it does not fit
+static int flush_run(Replay* rp) {
+    uint8_t tmp[7];
+    int n = 0;
+    uint32_t run = rp->run;
+
+    tmp[n++] = rp->mask;
+    tmp[n++] = rp->mask >> 8;
+    do {
+        uint8_t byte = run & 0x7F;
+        run >>= 7;
+        tmp[n++] = run ? (byte | 0x80) : byte;
+    } while (run);
+
+    if (rp->len + n > rp->cap) {
+        rp->full = 1;
+        return 0;
+    }
+    memcpy(rp->out + rp->len, tmp, n);
+    rp->len += n;
+    
+    // Keep the header's frame count in step so the buffer is a playable
+    // replay at any moment (e.g. dumped from an emulator mid-session)
+    put_u32(rp->out + 12, rp->frames);
+    return 1;
+}
+
+void replay_record_begin(Replay* rp, uint8_t* buf, int cap, uint32_t seed, GfxInfo gfx) {
+    memset(rp, 0, sizeof(Replay));
+    rp->out = buf;
+    rp->cap = cap;
+    rp->seed = seed;
+    rp->gfx = gfx;
+    rp->len = REPLAY_HEADER_SIZE;
+    rp->full = cap < REPLAY_HEADER_SIZE;
+    if (!rp->full) write_header(rp);
+}
+
+int replay_record(Replay* rp, uint32_t buttons) {
+    if (rp->full) return 0;
+
+    uint16_t mask = buttons & 0xFFFF;
+    if (rp->run && mask != rp->mask) {
+        if (!flush_run(rp)) return 0;
+        rp->run = 0;
+    }
+    rp->mask = mask;
+    rp->run++;
+    rp->frames++;
+    return 1;
+}
+
+int replay_record_end(Replay* rp) {
+    if (rp->cap < REPLAY_HEADER_SIZE) return 0;
+
+    // A run that no longer fits is dropped along with its frames
+    if (rp->run && (rp->full || !flush_run(rp))) {
+        rp->frames -= rp->run;
+    }
+    rp->run = 0;
+    write_header(rp);
+    return rp->len;
+}
+
+int replay_play_begin(Replay* rp, const uint8_t* data, int len) {
+    memset(rp, 0, sizeof(Replay));
+    if (len < REPLAY_HEADER_SIZE || memcmp(data, "SNKR", 4) != 0) return 0;
+    if (data[4] != REPLAY_VERSION) return 0;
+
+    rp->in = data;
+    rp->cap = len;
+    rp->len = REPLAY_HEADER_SIZE;
+    rp->gfx.tiles_w = data[5];
+    rp->gfx.tiles_h = data[6];
+    rp->gfx.tile_px = data[7];
+    rp->seed = get_u32(data + 8);
+    rp->frames = get_u32(data + 12);
+    return 1;
+}
+
+int replay_next(Replay* rp, uint32_t* buttons) {
+    // Pull the next run once the current one is used up
+    while (rp->run == 0) {
+        if (rp->len + 2 > rp->cap) return 0;
+        rp->mask = rp->in[rp->len] | (rp->in[rp->len + 1] << 8);
+        rp->len += 2;
+        uint32_t run = 0;
+        int shift = 0;
+        uint8_t byte;
+        do {
+            if (rp->len >= rp->cap || shift > 28) return 0;
+            byte = rp->in[rp->len++];
+            run |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        rp->run = run;
+    }
+
+    rp->run--;
+    *buttons = rp->mask;
+    return 1;
+}
@@ -0,0 +1,42 @@
+// Deterministic input replays for Snake
+// A session is fully determined by its RNG seed, board geometry and the
+// per-frame Buttons masks fed to game_update, so that is all we store:
+//
+//   "SNKR" | version u8 | tiles_w u8 | tiles_h u8 | tile_px u8 |
+//   seed u32le | frames u32le | runs...
+//
+// Each run is the 16-bit input mask (Buttons plus GAME_INPUT_DEMO, little
+// endian) followed by its length in frames as a LEB128 varint, so idle
+// stretches cost three or four bytes.
+#pragma once
+#include <stdint.h>
+#include "platform.h"
+
+#define REPLAY_VERSION 3    // 2: food placed by core/rng.h instead of libc rand()
+                            // 3: 16-bit masks so attract demos replay
+#define REPLAY_HEADER_SIZE 16
+
+typedef struct {
+    uint32_t seed;
+    GfxInfo gfx;
+    uint32_t frames;        // Frames recorded / total frames in the replay
+
+    uint8_t* out;           // Record: caller-provided buffer
+    const uint8_t* in;      // Play: encoded replay
+    int cap;                // Buffer size in bytes
+    int len;                // Bytes used (record) / read position (play)
+
+    uint16_t mask;          // Current run mask
+    uint32_t run;           // Record: frames in current run, play: frames left
+    int full;               // Record: buffer ran out, later frames dropped
+} Replay;
+
+// Recording - returns 0 once the buffer is full
+void replay_record_begin(Replay* rp, uint8_t* buf, int cap, uint32_t seed, GfxInfo gfx);
+int replay_record(Replay* rp, uint32_t buttons);
+int replay_record_end(Replay* rp);      // Flushes the last run, returns encoded size
+
+// Playback - replay_play_begin returns 0 for a malformed header,
+// replay_next returns 0 once every recorded frame has been produced
+int replay_play_begin(Replay* rp, const uint8_t* data, int len);
+int replay_next(Replay* rp, uint32_t* buttons);
@@ -0,0 +1,56 @@
+// Portable random numbers for Snake - xoshiro128** with per-Game state
+// The same seed gives the same sequence on every target and toolchain (libc
+// rand() differs between newlib and glibc), so replays stay portable. Only
+// 32-bit shifts, rotates and multiplies by 5 and 9 - cheap on the ARM7.
+#pragma once
+#include <stdint.h>
+
+typedef struct {
+    uint32_t s[4];
+} Rng;
+
+static inline uint32_t rng_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// Expand a 32-bit seed into the full state with splitmix32, so nearby
+// seeds still start far apart and the state is never all zero
+static inline void rng_seed(Rng* rng, uint32_t seed) {
+    for (int i = 0; i < 4; i++) {
+        uint32_t z = (seed += 0x9E3779B9u);
+        z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+        rng->s[i] = z ^ (z >> 16);
+    }
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) rng->s[0] = 1;
+}
+
+static inline uint32_t rng_next(Rng* rng) {
+    uint32_t* s = rng->s;
+    uint32_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 11);
+    return result;
+}
+
+// Uniform value in [0, range) without modulo bias (Lemire's multiply-shift:
+// one 32x32->64 multiply, and a division only in the rare rejection case)
+static inline uint32_t rng_range(Rng* rng, uint32_t range) {
+    uint64_t m = (uint64_t)rng_next(rng) * range;
+    uint32_t low = (uint32_t)m;
+
+    if (low < range) {
+        uint32_t threshold = -range % range;
+        while (low < threshold) {
+            m = (uint64_t)rng_next(rng) * range;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
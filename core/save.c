@@ -0,0 +1,45 @@
+// Persistent high score and settings - versioned, checksummed record
+#include "save.h"
+#include <string.h>
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t checksum(const uint8_t* p, int len) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < len; i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+int save_decode(SaveData* data, const uint8_t* rec, int len) {
+    memset(data, 0, sizeof(SaveData));
+
+    if (len != SAVE_SIZE) return 0;
+    if (memcmp(rec, "SNKS", 4) != 0 || rec[4] != SAVE_VERSION) return 0;
+    if (get_u32(rec + 12) != checksum(rec, 12)) return 0;
+
+    int32_t high = (int32_t)get_u32(rec + 8);
+    data->high_score = high > 0 ? high : 0;
+    data->settings = rec[5];
+    return 1;
+}
+
+void save_encode(const SaveData* data, uint8_t rec[SAVE_SIZE]) {
+    memcpy(rec, "SNKS", 4);
+    rec[4] = SAVE_VERSION;
+    rec[5] = data->settings;
+    rec[6] = 0;
+    rec[7] = 0;
+    put_u32(rec + 8, (uint32_t)data->high_score);
+    put_u32(rec + 12, checksum(rec, 12));
+}
@@ -0,0 +1,28 @@
+// Persistent high score and settings for Snake
+// The record is a fixed 16-byte block; Game moves it through its save hooks
+// (plat_save_read/write unless replaced, see GameHooks):
+//
+//   "SNKS" | version u8 | settings u8 | reserved u16 | high_score u32le |
+//   checksum u32le (FNV-1a of the first 12 bytes)
+//
+// A missing, foreign or corrupted block loads as defaults.
+#pragma once
+#include <stdint.h>
+
+#define SAVE_VERSION 1
+#define SAVE_SIZE 16
+
+// Settings bits
+#define SETTING_OVERLAY (1 << 0)    // Frame-time overlay shown
+
+typedef struct {
+    int32_t high_score;
+    uint8_t settings;
+} SaveData;
+
+// Decode `len` bytes read from save memory; returns 0 (and fills defaults)
+// if they do not hold a valid record
+int save_decode(SaveData* data, const uint8_t* rec, int len);
+
+// Encode the record for writing back (the platform skips bytes that did not change)
+void save_encode(const SaveData* data, uint8_t rec[SAVE_SIZE]);
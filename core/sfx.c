@@ -0,0 +1,70 @@
+// Built-in sound effects - synthesized waveforms and per-effect voices
+#include "sfx.h"
+
+#define WAVE_LEN 32         // One cycle of the tonal waveforms
+#define NOISE_LEN 1024
+
+static int8_t square_pcm[WAVE_LEN];
+static int8_t triangle_pcm[WAVE_LEN];
+static int8_t noise_pcm[NOISE_LEN];
+static int built;
+
+static const MixSound square_wave = { square_pcm, WAVE_LEN, 1 };
+static const MixSound triangle_wave = { triangle_pcm, WAVE_LEN, 1 };
+static const MixSound noise_wave = { noise_pcm, NOISE_LEN, 1 };
+
+// Durations are whole mixed frames so the envelope steps line up with them
+#define FRAMES(n) ((n) * MIX_FRAME_SAMPLES)
+
+static const MixVoice voices[SFX_COUNT] = {
+    [SFX_EAT]      = { &square_wave,   MIX_STEP(660, WAVE_LEN), 600,  FRAMES(5),  48, 6 },
+    [SFX_HIT]      = { &noise_wave,    1 << MIX_FRAC,          -160,  FRAMES(20), 64, 3 },
+    [SFX_LEVEL_UP] = { &triangle_wave, MIX_STEP(440, WAVE_LEN), 500,  FRAMES(12), 56, 2 },
+    [SFX_START]    = { &square_wave,   MIX_STEP(523, WAVE_LEN), 150,  FRAMES(8),  40, 4 },
+    [SFX_PAUSE]    = { &triangle_wave, MIX_STEP(330, WAVE_LEN), 0,    FRAMES(4),  40, 8 },
+};
+
+void sfx_init(void) {
+    if (built) return;
+
+    for (int i = 0; i < WAVE_LEN; i++) {
+        square_pcm[i] = i < WAVE_LEN / 2 ? 96 : -96;
+        // -120 -> 120 -> -120 over one cycle
+        int t = i < WAVE_LEN / 2 ? i : WAVE_LEN - i;
+        triangle_pcm[i] = (int8_t)(t * 240 / (WAVE_LEN / 2) - 120);
+    }
+
+    // Private generator so sound never disturbs the game's random sequence
+    uint32_t seed = 0x2545F491;
+    for (int i = 0; i < NOISE_LEN; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        noise_pcm[i] = (int8_t)(seed >> 24);
+    }
+    built = 1;
+}
+
+const MixVoice* sfx_voice(uint8_t id) {
+    return id < SFX_COUNT ? &voices[id] : 0;
+}
+
+void sfx_play(Mixer* mixer, uint8_t id) {
+    const MixVoice* voice = sfx_voice(id);
+    if (voice) mixer_play(mixer, voice);
+}
+
+int sfx_render(uint8_t id, int8_t* out, int max) {
+    const MixVoice* voice = sfx_voice(id);
+    if (!voice) return 0;
+
+    Mixer mixer;
+    mixer_init(&mixer);
+    mixer_play(&mixer, voice);
+
+    int n = 0;
+    while (n < max && mixer_active(&mixer)) {
+        int block = max - n < MIX_FRAME_SAMPLES ? max - n : MIX_FRAME_SAMPLES;
+        mixer_mix(&mixer, out + n, block);
+        n += block;
+    }
+    return n;
+}
@@ -0,0 +1,26 @@
+// Built-in sound effects for Snake
+// Each effect is a short voice (pitch sweep + volume decay) over one of a
+// few synthesized 8-bit waveforms, so no sample assets are needed. The ids
+// are what the core passes to plat_sfx.
+#pragma once
+#include <stdint.h>
+#include "mixer.h"
+
+typedef enum {
+    SFX_EAT,        // Food eaten (plat_beep_ok)
+    SFX_HIT,        // Collision (plat_beep_hit)
+    SFX_LEVEL_UP,
+    SFX_START,
+    SFX_PAUSE,
+    SFX_COUNT
+} SfxId;
+
+#define SFX_MAX_SAMPLES (24 * MIX_FRAME_SAMPLES)    // Longest effect, for sfx_render
+
+void sfx_init(void);                    // Build the waveform tables (safe to call again)
+const MixVoice* sfx_voice(uint8_t id);  // NULL for an unknown id
+void sfx_play(Mixer* mixer, uint8_t id);
+
+// Render an effect on its own into `out` (for platforms that mix in
+// hardware, such as the NDS). Returns the number of samples written.
+int sfx_render(uint8_t id, int8_t* out, int max);
@@ -1,9 +1,41 @@
 // Main entry point for multi-platform Snake game
 #include <stddef.h>
 #include "core/game.h"
+#include "core/replay.h"
+#include "core/profile.h"
+#include "core/attract.h"
 
-// Game instance - allocate in EWRAM for speed
-static Game game __attribute__((section(".ewram")));
+#ifdef PLATFORM_GBA
+#include <gba.h>    // EWRAM_BSS
+#else
+#define EWRAM_BSS
+#endif
+
+#define GAME_SEED 0x12345678
+#define SESSION_REPLAY_SIZE 4096
+
+// Game instance - plain .bss, which devkitARM places in 32-bit IWRAM
+// (EWRAM's 16-bit bus and wait states made every tick slower)
+static Game game;
+
+// Session recording - every frame's buttons go into an RLE replay so a bug
+// report can ship the exact session (dump session_replay_data from the
+// emulator/debugger - static symbols stay in the ELF - and feed it to
+// snake-replay on the host). Written a few bytes a second, so it lives in
+// EWRAM rather than taking 4 KB of IWRAM
+static Replay session_replay;
+static uint8_t session_replay_data[SESSION_REPLAY_SIZE] EWRAM_BSS;
+
+// Per-phase frame timing, overlay toggled with SELECT
+static Profiler profiler;
+
+// Attract mode - the autopilot plays from the menu until any key is pressed
+static Attract attract;
+
+#ifdef PLATFORM_GBA
+_Static_assert(sizeof(Game) + sizeof(Replay) + sizeof(Profiler) + sizeof(Attract) <= 12 * 1024,
+               "main.c's IWRAM state has outgrown its share of the 32 KB");
+#endif
 
 int main(void) {
     // Initialize platform
@@ -14,23 +46,50 @@ int main(void) {
     
     // Initialize game
     game_init(&game);
+    profile_init(&profiler);
+    attract_init(&attract);
+    game.profiler = &profiler;
+    profiler.visible = (game.settings & SETTING_OVERLAY) != 0;
     
     // Seed random number generator
-    plat_seed_random(0x12345678);
+    game_seed(&game, GAME_SEED);
+    replay_record_begin(&session_replay, session_replay_data, SESSION_REPLAY_SIZE,
+                        GAME_SEED, game.gfx);
     
     // Main game loop
     while (1) {
         // Wait for VBlank
         plat_vblank();
         
+        // Mix the next audio block
+        uint32_t tm = plat_cycles();
+        plat_audio();
+        uint32_t mix = plat_cycles() - tm;
+        
         // Get input
         uint32_t buttons = plat_buttons();
         
-        // Update game logic
+        // Update game logic (autopilot decisions count as update time)
+        uint32_t t0 = plat_cycles();
+        buttons = attract_input(&attract, &game, buttons);
+        replay_record(&session_replay, buttons);
+        game.input_stamp = plat_input_frame();
         game_update(&game, buttons);
+        if (game.buttons_pressed & BTN_SELECT) {
+            game.settings ^= SETTING_OVERLAY;
+            profiler.visible = (game.settings & SETTING_OVERLAY) != 0;
+        }
+        if (game.turn_applied) {
+            profile_latency(&profiler, plat_frame() - game.turn_applied_stamp);
+        }
         
         // Render
+        uint32_t t1 = plat_cycles();
         game_render(&game);
+        profile_record(&profiler, t1 - t0, plat_cycles() - t1, mix);
+        
+        // Persist a new high score / settings once play stops (outside the timed phases)
+        game_save(&game);
     }
     
     return 0;
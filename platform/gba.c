@@ -1,32 +1,117 @@
 // GBA platform implementation for Snake game - simplified version
+// Video lives in the backend selected with GBA_VIDEO (gba_mode3.c / gba_mode0.c)
 #include <gba.h>
-#include <stdlib.h>
 #include "platform.h"
+#include "gba_video.h"
+#include "gba_fill.h"
+#include "input_ring.h"
+#include "mixer.h"
+#include "sfx.h"
+
+// Cycles in one frame: 228 scanlines x 1232 cycles
+#define GBA_FRAME_CYCLES 280896
+
+// Direct Sound A fed by DMA1, one sample per timer 0 overflow.
+// MIX_RATE divides the frame exactly, so a buffer lasts one VBlank period.
+#define SOUND_TIMER_RELOAD  (65536 - GBA_FRAME_CYCLES / MIX_FRAME_SAMPLES)
+#define SOUNDCNT_X_ENABLE   (1 << 7)
+#define SOUNDCNT_H_A_FULL   (1 << 2)    // Channel A at 100%
+#define SOUNDCNT_H_A_RIGHT  (1 << 8)
+#define SOUNDCNT_H_A_LEFT   (1 << 9)
+#define SOUNDCNT_H_A_TIMER0 (0 << 10)   // Channel A clocked by timer 0
+#define SOUNDCNT_H_A_RESET  (1 << 11)   // Reset FIFO A
+#define DMA_FIFO            (DMA_DST_FIXED | DMA_REPEAT | DMA32 | DMA_SPECIAL | DMA_ENABLE)
+
+// Battery-backed SRAM sits on an 8-bit bus - every access must be a byte
+#define SRAM ((volatile u8*)0x0E000000)
+#define SRAM_SIZE 0x8000
+
+// Save-type tag that flashcarts and emulators look for in the ROM
+__attribute__((used, aligned(4))) static const char saveType[] = "SRAM_V113";
+
+// Input latched by the VBlank interrupt
+static InputRing inputRing;
+static volatile uint32_t vblankCount;
+static uint16_t heldKeys;       // Last merged key state, kept if no new sample arrived
+static uint32_t inputFrame;     // Stamp of the oldest sample merged by plat_buttons
+
+// Audio double buffer: DMA1 plays one half while plat_audio mixes the other
+static Mixer mixer;
+static int8_t soundBuffer[2][MIX_FRAME_SAMPLES] __attribute__((aligned(4)));
+static volatile int soundPlaying;   // Half currently being played
+
+// Restart DMA1 on the buffer mixed during the previous frame
+static void gba_sound_vblank(void) {
+    soundPlaying ^= 1;
+    REG_DMA1CNT = 0;
+    REG_DMA1SAD = (u32)soundBuffer[soundPlaying];
+    REG_DMA1CNT = DMA_FIFO;
+}
+
+// VBlank interrupt: swap audio buffers, latch the keypad, then let the video backend commit
+static void gba_vblank_isr(void) {
+    gba_sound_vblank();
+    vblankCount++;
+    input_ring_push(&inputRing, vblankCount, ~REG_KEYINPUT & 0x03FF);
+    gba_video_vblank();
+}
 
-// GBA-specific constants
-#define GBA_TILES_W 30
-#define GBA_TILES_H 20
-#define GBA_TILE_PX 8
+static void gba_sound_init(void) {
+    mixer_init(&mixer);
+    sfx_init();
 
-// Screen buffer for Mode 3
-static volatile u16* const videoBuffer = (u16*)0x06000000;
+    REG_SOUNDCNT_X = SOUNDCNT_X_ENABLE;
+    REG_SOUNDCNT_H = SOUNDCNT_H_A_FULL | SOUNDCNT_H_A_RIGHT | SOUNDCNT_H_A_LEFT |
+                     SOUNDCNT_H_A_TIMER0 | SOUNDCNT_H_A_RESET;
+
+    REG_DMA1DAD = (u32)&REG_FIFO_A;
+    REG_DMA1SAD = (u32)soundBuffer[0];
+    REG_DMA1CNT = DMA_FIFO;
+    soundPlaying = 0;
+
+    REG_TM0CNT_L = SOUND_TIMER_RELOAD;
+    REG_TM0CNT_H = TIMER_START;
+}
 
 // Initialize GBA hardware
 void plat_init(void) {
+    // Profiling clock: timer 2 counts every CPU cycle, timer 3 counts its overflows
+    REG_TM2CNT_H = 0;
+    REG_TM3CNT_H = 0;
+    REG_TM2CNT_L = 0;
+    REG_TM3CNT_L = 0;
+    REG_TM3CNT_H = TIMER_COUNT | TIMER_START;
+    REG_TM2CNT_H = TIMER_START;
+    
+#ifdef GBA_FILL_CHECK
+    // Before video setup and IRQs: it scribbles over VRAM and times with the clock above
+    gba_fill_check();
+#endif
+    
     irqInit();
+    irqSet(IRQ_VBLANK, gba_vblank_isr);
     irqEnable(IRQ_VBLANK);
     
-    // Mode 3: bitmap mode for simplicity
-    REG_DISPCNT = MODE_3 | BG2_ON;
+    gba_video_init();
+    gba_sound_init();
 }
 
 void plat_vblank(void) {
     VBlankIntrWait();
 }
 
+void plat_audio(void) {
+    // The other half starts playing at the next VBlank
+    mixer_mix(&mixer, soundBuffer[soundPlaying ^ 1], MIX_FRAME_SAMPLES);
+}
+
 uint32_t plat_buttons(void) {
-    scanKeys();
-    u16 keys = keysDown();
+    // Held state - the core does its own edge detection. Everything latched
+    // since the last call is merged, so an overrunning frame loses no press.
+    if (!input_ring_drain(&inputRing, &heldKeys, &inputFrame)) {
+        inputFrame = vblankCount;
+    }
+    u16 keys = heldKeys;
     
     uint32_t buttons = 0;
     if (keys & KEY_UP)    buttons |= BTN_UP;
@@ -41,81 +126,63 @@ uint32_t plat_buttons(void) {
     return buttons;
 }
 
-void plat_clear_bg(void) {
-    // Clear screen to black
-    DMA3COPY(&(u16){0}, videoBuffer, DMA_SRC_FIXED | DMA16 | (240*160));
-}
-
-void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal) {
-    // Simple tile drawing using Mode 3
-    if (tx < 0 || tx >= 30 || ty < 0 || ty >= 20) return;
-    
-    int px = tx * 8;
-    int py = ty * 8;
-    u16 color = RGB5(31, 31, 31); // White for now
-    
-    for (int y = 0; y < 8; y++) {
-        for (int x = 0; x < 8; x++) {
-            videoBuffer[(py + y) * 240 + (px + x)] = color;
-        }
-    }
-}
-
-void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
-    // Simple sprite drawing using Mode 3
-    if (px < 0 || px >= 240 || py < 0 || py >= 160) return;
-    
-    u16 color;
-    switch (pal) {
-        case 1: color = RGB5(31, 0, 0); break;   // Red
-        case 2: color = RGB5(31, 31, 31); break; // White
-        case 3: color = RGB5(0, 31, 0); break;   // Green
-        default: color = RGB5(31, 31, 0); break; // Yellow
-    }
-    
-    for (int y = 0; y < 8; y++) {
-        for (int x = 0; x < 8; x++) {
-            if (px + x < 240 && py + y < 160) {
-                videoBuffer[(py + y) * 240 + (px + x)] = color;
-            }
-        }
-    }
+uint32_t plat_frame(void) {
+    return vblankCount;
 }
 
-void plat_sprite_hide(int id) {
-    // Nothing to do in Mode 3
-}
-
-void plat_present(void) {
-    // Nothing to do in Mode 3
+uint32_t plat_input_frame(void) {
+    return inputFrame;
 }
 
 GfxInfo plat_gfx_info(void) {
     GfxInfo info = {
         .tiles_w = GBA_TILES_W,
         .tiles_h = GBA_TILES_H,
-        .tile_px = GBA_TILE_PX
+        .tile_px = GBA_TILE_PX,
+        .sprite_snap = gbaSpriteSnap
     };
     return info;
 }
 
-void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTilesLen,
-                      const uint16_t* objPal, const uint8_t* objTiles, int objTilesLen) {
-    // No assets needed for simple Mode 3 version
+uint32_t plat_cycles(void) {
+    // Re-read if the low half wrapped between the two reads
+    u16 hi, lo;
+    do {
+        hi = REG_TM3CNT_L;
+        lo = REG_TM2CNT_L;
+    } while (hi != REG_TM3CNT_L);
+    
+    return ((uint32_t)hi << 16) | lo;
+}
+
+uint32_t plat_cycles_per_frame(void) {
+    return GBA_FRAME_CYCLES;
+}
+
+int plat_save_read(uint8_t* buf, int len) {
+    if (len > SRAM_SIZE) len = SRAM_SIZE;
+    for (int i = 0; i < len; i++) {
+        buf[i] = SRAM[i];
+    }
+    return len;
+}
+
+void plat_save_write(const uint8_t* buf, int len) {
+    // Rewrite only bytes that changed
+    if (len > SRAM_SIZE) len = SRAM_SIZE;
+    for (int i = 0; i < len; i++) {
+        if (SRAM[i] != buf[i]) SRAM[i] = buf[i];
+    }
 }
 
 void plat_beep_ok(void) {
-    // Simple beep - no sound for now
+    plat_sfx(SFX_EAT);
 }
 
 void plat_beep_hit(void) {
-    // Simple beep - no sound for now
+    plat_sfx(SFX_HIT);
 }
 
-void plat_seed_random(uint32_t seed) {
-    srand(seed);
+void plat_sfx(uint8_t id) {
+    sfx_play(&mixer, id);
 }
-
-uint32_t plat_random(void) {
-    return rand();
-}
\ No newline at end of file
@@ -0,0 +1,12 @@
+// Reference C versions of the 8x8 cell fills (GBA_FILL=c)
+// Thumb code run from ROM - kept as the baseline gba_fill_arm.s is checked against
+#include "gba_fill.h"
+#include "gba_fill_ref.h"
+
+void gba_fill_cell16(volatile void* dst, u32 pair) {
+    gba_fill_ref_cell16(dst, pair);
+}
+
+void gba_fill_cell8(volatile void* dst, u32 quad) {
+    gba_fill_ref_cell8(dst, quad);
+}
@@ -0,0 +1,28 @@
+// 8x8 solid cell fills shared by the GBA bitmap video backends
+// Built either from the ARM-mode IWRAM routines in gba_fill_arm.s
+// (GBA_FILL=arm, default) or the portable C loops in gba_fill.c (GBA_FILL=c).
+
+#pragma once
+#include <gba.h>
+
+// Mode 3: dst is the cell's first pixel, pair is the colour in both halfwords
+__attribute__((long_call)) void gba_fill_cell16(volatile void* dst, u32 pair);
+
+// Mode 4: dst is the cell's first pixel, quad is the palette index in all four bytes
+__attribute__((long_call)) void gba_fill_cell8(volatile void* dst, u32 quad);
+
+#ifdef GBA_FILL_CHECK
+// Debug self-test (GBA_FILL_CHECK=1), run by plat_init before video setup:
+// compares both fills with the C reference at every word offset and colour,
+// then times each against the reference with timers 2/3. Results go to the
+// mGBA debug log and gbaFillCheck; a mismatch stops on a red screen.
+typedef struct {
+    u32 failures;
+    u32 cell16_cycles, ref16_cycles;    // CPU cycles per cell, whole Mode 3 screen
+    u32 cell8_cycles, ref8_cycles;      // CPU cycles per cell, whole Mode 4 page
+} GbaFillCheck;
+
+extern GbaFillCheck gbaFillCheck;
+
+void gba_fill_check(void);
+#endif
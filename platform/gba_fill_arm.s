@@ -0,0 +1,36 @@
+@ ARM-mode 8x8 cell fills, run from IWRAM (GBA_FILL=arm)
+@ Same contract as the C versions in gba_fill.c: r0 = first pixel of the
+@ cell, r1 = fill value replicated across the word. Each row is a single
+@ stmia burst, fully unrolled, with no stack use.
+
+    .section .iwram, "ax", %progbits
+    .arm
+    .align 2
+
+@ void gba_fill_cell16(volatile void* dst, u32 pair) - Mode 3, 16bpp
+    .global gba_fill_cell16
+    .type gba_fill_cell16, %function
+gba_fill_cell16:
+    mov     r2, r1
+    mov     r3, r1
+    mov     r12, r1
+    .rept 7
+    stmia   r0, {r1, r2, r3, r12}   @ 8 pixels
+    add     r0, r0, #480            @ Next scanline (240 * 2 bytes)
+    .endr
+    stmia   r0, {r1, r2, r3, r12}
+    bx      lr
+    .size gba_fill_cell16, . - gba_fill_cell16
+
+@ void gba_fill_cell8(volatile void* dst, u32 quad) - Mode 4, 8bpp
+    .global gba_fill_cell8
+    .type gba_fill_cell8, %function
+gba_fill_cell8:
+    mov     r2, r1
+    .rept 7
+    stmia   r0, {r1, r2}            @ 8 pixels
+    add     r0, r0, #240            @ Next scanline (240 bytes)
+    .endr
+    stmia   r0, {r1, r2}
+    bx      lr
+    .size gba_fill_cell8, . - gba_fill_cell8
@@ -0,0 +1,148 @@
+// Debug self-test for the 8x8 cell fills (GBA_FILL_CHECK=1)
+// Runs once from plat_init, before the video backend owns VRAM: checks
+// gba_fill_cell16/gba_fill_cell8 against the C reference loops in
+// gba_fill_ref.h, then times both with the timer 2/3 cycle counter.
+#include <gba.h>
+#include <stdio.h>
+#include "platform.h"
+#include "gba_video.h"
+#include "gba_fill.h"
+#include "gba_fill_ref.h"
+
+#define VRAM_BASE       ((volatile u32*)0x06000000)
+#define ROW16_WORDS     (GBA_SCREEN_W / 2)  // Mode 3 scanline
+#define ROW8_WORDS      (GBA_SCREEN_W / 4)  // Mode 4 scanline
+#define CELL16_WORDS    (GBA_TILE_PX / 2)
+#define CELL8_WORDS     (GBA_TILE_PX / 4)
+#define SCREEN_CELLS    (GBA_TILES_W * GBA_TILES_H)
+
+// Scratch screens: a guard scanline above and below the cell and a guard
+// word either side of every row, so stray stores show up as differences
+#define CHECK_ROWS      (GBA_TILE_PX + 2)
+#define CHECK_WORDS     (1 + CHECK_ROWS * ROW16_WORDS + 1)
+
+// mGBA debug log
+#define MGBA_LOG_STRING ((char*)0x04FFF600)
+#define MGBA_LOG_SEND   (*(vu16*)0x04FFF700)
+#define MGBA_LOG_ENABLE (*(vu16*)0x04FFF780)
+#define MGBA_LOG_INFO   (3 | 0x100)
+#define MGBA_LOG_ERROR  (1 | 0x100)
+
+typedef void (*FillFn)(volatile void* dst, u32 value);
+
+GbaFillCheck gbaFillCheck;
+
+static EWRAM_BSS u32 checkFill[CHECK_WORDS];
+static EWRAM_BSS u32 checkRef[CHECK_WORDS];
+
+// Out-of-line copies of the reference loops, called the way gba_fill.c is
+static __attribute__((noinline)) void ref_cell16(volatile void* dst, u32 pair) {
+    gba_fill_ref_cell16(dst, pair);
+}
+
+static __attribute__((noinline)) void ref_cell8(volatile void* dst, u32 quad) {
+    gba_fill_ref_cell8(dst, quad);
+}
+
+static void check_log(int level, const char* msg) {
+    MGBA_LOG_ENABLE = 0xC0DE;
+    if (MGBA_LOG_ENABLE != 0x1DEA) return;     // Not running under mGBA
+
+    int i = 0;
+    for (; msg[i] && i < 255; i++) MGBA_LOG_STRING[i] = msg[i];
+    MGBA_LOG_STRING[i] = 0;
+    MGBA_LOG_SEND = level;
+}
+
+// Fill one cell at word `offset` along the second scratch row with both
+// versions; returns 1 if any word of the surrounding window differs
+static int check_cell(FillFn fill, FillFn ref, int stride, int width, int offset, u32 value) {
+    // Reset the window to something the fill never writes
+    for (int r = 0; r < CHECK_ROWS; r++) {
+        for (int w = -1; w <= width; w++) {
+            int i = 1 + r * stride + offset + w;
+            checkFill[i] = ~value;
+            checkRef[i] = ~value;
+        }
+    }
+
+    fill(&checkFill[1 + stride + offset], value);
+    ref(&checkRef[1 + stride + offset], value);
+
+    for (int r = 0; r < CHECK_ROWS; r++) {
+        for (int w = -1; w <= width; w++) {
+            int i = 1 + r * stride + offset + w;
+            if (checkFill[i] != checkRef[i]) return 1;
+        }
+    }
+    return 0;
+}
+
+static void check_fail(const char* name, int offset, u32 value) {
+    char msg[80];
+    snprintf(msg, sizeof(msg), "fill check: %s differs at word %d, value %08lx",
+             name, offset, (unsigned long)value);
+    check_log(MGBA_LOG_ERROR, msg);
+    gbaFillCheck.failures++;
+}
+
+// Cycles per cell to fill a whole screen, call and loop overhead included
+static u32 time_screen(FillFn fill, int stride, int width, u32 value) {
+    u32 start = plat_cycles();
+    for (int ty = 0; ty < GBA_TILES_H; ty++) {
+        volatile u32* row = VRAM_BASE + ty * GBA_TILE_PX * stride;
+        for (int tx = 0; tx < GBA_TILES_W; tx++) {
+            fill(row + tx * width, value);
+        }
+    }
+    return (plat_cycles() - start) / SCREEN_CELLS;
+}
+
+void gba_fill_check(void) {
+    char msg[80];
+
+    // Every 15-bit colour, walking the start through every word offset
+    // along a Mode 3 scanline
+    int offsets16 = ROW16_WORDS - CELL16_WORDS + 1;
+    for (u32 c = 0; c < 0x8000; c++) {
+        int offset = c % offsets16;
+        if (check_cell(gba_fill_cell16, ref_cell16, ROW16_WORDS, CELL16_WORDS, offset, c | (c << 16))) {
+            check_fail("gba_fill_cell16", offset, c | (c << 16));
+            break;
+        }
+    }
+
+    // Every palette index at every word offset along a Mode 4 scanline
+    int offsets8 = ROW8_WORDS - CELL8_WORDS + 1;
+    for (u32 index = 0; index < 256 && !gbaFillCheck.failures; index++) {
+        for (int offset = 0; offset < offsets8; offset++) {
+            if (check_cell(gba_fill_cell8, ref_cell8, ROW8_WORDS, CELL8_WORDS, offset, index * 0x01010101)) {
+                check_fail("gba_fill_cell8", offset, index * 0x01010101);
+                break;
+            }
+        }
+    }
+
+    // Stores outside the windows land in the same place in both copies
+    for (int i = 0; i < CHECK_WORDS && !gbaFillCheck.failures; i++) {
+        if (checkFill[i] != checkRef[i]) check_fail("stray store", i, checkFill[i]);
+    }
+
+    // Interrupts are not enabled yet, so nothing lands inside the timed loops
+    gbaFillCheck.cell16_cycles = time_screen(gba_fill_cell16, ROW16_WORDS, CELL16_WORDS, 0x7FFF7FFF);
+    gbaFillCheck.ref16_cycles = time_screen(ref_cell16, ROW16_WORDS, CELL16_WORDS, 0x7FFF7FFF);
+    gbaFillCheck.cell8_cycles = time_screen(gba_fill_cell8, ROW8_WORDS, CELL8_WORDS, 0x01010101);
+    gbaFillCheck.ref8_cycles = time_screen(ref_cell8, ROW8_WORDS, CELL8_WORDS, 0x01010101);
+
+    snprintf(msg, sizeof(msg), "fill check: cell16 %lu vs C %lu, cell8 %lu vs C %lu cycles/cell",
+             (unsigned long)gbaFillCheck.cell16_cycles, (unsigned long)gbaFillCheck.ref16_cycles,
+             (unsigned long)gbaFillCheck.cell8_cycles, (unsigned long)gbaFillCheck.ref8_cycles);
+    check_log(gbaFillCheck.failures ? MGBA_LOG_ERROR : MGBA_LOG_INFO, msg);
+
+    if (gbaFillCheck.failures) {
+        // Stop on a red backdrop rather than run with a broken renderer
+        REG_DISPCNT = MODE_0;
+        BG_PALETTE[0] = RGB5(31, 0, 0);
+        for (;;) { }
+    }
+}
@@ -0,0 +1,32 @@
+// Reference C loops for the 8x8 cell fills - the GBA_FILL=c build
+// (gba_fill.c) and the GBA_FILL_CHECK self-test (gba_fill_check.c) both
+// expand these, so the test compares the ARM routines with the exact
+// code the C build would run.
+
+#pragma once
+#include <gba.h>
+#include "gba_video.h"
+
+static inline void gba_fill_ref_cell16(volatile void* dst, u32 pair) {
+    // 8 pixels = 4 words per row, 240 pixels = 120 words per scanline
+    volatile u32* row = dst;
+
+    for (int y = 0; y < GBA_TILE_PX; y++) {
+        row[0] = pair;
+        row[1] = pair;
+        row[2] = pair;
+        row[3] = pair;
+        row += GBA_SCREEN_W / 2;
+    }
+}
+
+static inline void gba_fill_ref_cell8(volatile void* dst, u32 quad) {
+    // 8 pixels = 2 words per row, 240 pixels = 60 words per scanline
+    volatile u32* row = dst;
+
+    for (int y = 0; y < GBA_TILE_PX; y++) {
+        row[0] = quad;
+        row[1] = quad;
+        row += GBA_SCREEN_W / 4;
+    }
+}
@@ -0,0 +1,175 @@
+// GBA Mode 0 video backend - BG0 tilemap plus hardware OBJ sprites
+// All drawing goes to shadow copies in IWRAM; the VBlank interrupt commits
+// them to VRAM/OAM with one DMA each, so rendering cost no longer depends
+// on how many pixels are covered.
+#include <gba.h>
+#include "platform.h"
+#include "gba_video.h"
+
+// VRAM layout
+#define BG_CHARBLOCK    ((u32*)0x06000000)  // Charblock 0: BG0 4bpp tiles
+#define BG_SCREENBLOCK  ((u16*)0x0600F800)  // Screenblock 31: BG0 32x32 map
+#define OBJ_CHARBLOCK   ((u32*)0x06010000)  // OBJ 4bpp tiles (1D mapping)
+#define BG_PAL          ((u16*)0x05000000)
+#define OBJ_PAL         ((u16*)0x05000200)
+#define OAM_MEM         ((u32*)0x07000000)
+
+#define MAP_W           32
+#define TILE_WORDS      8                   // 8x8 4bpp tile = 32 bytes
+#define BLANK_TILE      511                 // Last charblock-0 tile, kept empty
+#define FALLBACK_TILES  128                 // Solid tiles used when no assets are loaded
+#define OAM_COUNT       128
+
+// OAM attribute bits
+#define ATTR0_HIDE      (1 << 9)
+#define ATTR2_PAL(n)    ((n) << 12)
+
+typedef struct {
+    u16 attr0, attr1, attr2, fill;
+} ObjAttr;
+
+// Shadow state committed during VBlank (lives in IWRAM .bss)
+static ObjAttr shadowOam[OAM_COUNT] __attribute__((aligned(4)));
+static u16 shadowMap[GBA_TILES_H][MAP_W] __attribute__((aligned(4)));
+static volatile int commitPending;
+static volatile int oamHigh;        // Entries 0..oamHigh-1 touched since the last commit
+static int oamUploadBytes;
+
+// VBlank handler - copy shadow OAM and tilemap while the screen is not being drawn.
+// Uses DMA0 so it cannot clobber a DMA3 transfer the main loop is setting up.
+void gba_video_vblank(void) {
+    if (!commitPending) return;
+
+    // Only the touched prefix of OAM needs to go up
+    if (oamHigh) {
+        DMA0COPY(shadowOam, OAM_MEM, DMA32 | (oamHigh * sizeof(ObjAttr) / 4));
+    }
+    DMA0COPY(shadowMap, BG_SCREENBLOCK, DMA32 | (sizeof(shadowMap) / 4));
+    oamHigh = 0;
+    commitPending = 0;
+}
+
+// Fill a run of 4bpp tiles with a single palette index
+static void fill_tiles(u32* dst, int first, int count, u32 nibbles) {
+    DMA3COPY(&nibbles, dst + first * TILE_WORDS, DMA_SRC_FIXED | DMA32 | (count * TILE_WORDS));
+}
+
+// Hardware sprites move by the pixel
+const int gbaSpriteSnap = 0;
+
+void gba_video_init(void) {
+    // Mode 0: BG0 text layer and 1D-mapped sprites
+    REG_DISPCNT = MODE_0 | BG0_ON | OBJ_ON | OBJ_1D_MAP;
+    REG_BG0CNT = CHAR_BASE(0) | SCREEN_BASE(31) | BG_SIZE_0;
+
+    // Blank tile for cleared map entries
+    fill_tiles(BG_CHARBLOCK, BLANK_TILE, 1, 0);
+
+    // Placeholder art until real tiles are loaded: every tile is a solid
+    // block of colour 1, tinted per palette bank like the Mode 3 backend
+    fill_tiles(BG_CHARBLOCK, 0, FALLBACK_TILES, 0x11111111);
+    fill_tiles(OBJ_CHARBLOCK, 0, FALLBACK_TILES, 0x11111111);
+    for (int bank = 0; bank < 16; bank++) {
+        BG_PAL[bank * 16 + 1] = RGB5(31, 31, 31); // White for now
+        OBJ_PAL[bank * 16 + 1] = RGB5(31, 31, 0); // Yellow
+    }
+    OBJ_PAL[1 * 16 + 1] = RGB5(31, 0, 0);   // Red
+    OBJ_PAL[2 * 16 + 1] = RGB5(31, 31, 31); // White
+    OBJ_PAL[3 * 16 + 1] = RGB5(0, 31, 0);   // Green
+    BG_PAL[1 * 16 + 1] = RGB5(31, 0, 0);    // Red
+    BG_PAL[3 * 16 + 1] = RGB5(0, 31, 0);    // Green (snake body)
+    BG_PAL[0] = RGB5(0, 0, 0);              // Backdrop
+
+    // Start with everything hidden and an empty map
+    for (int i = 0; i < OAM_COUNT; i++) {
+        shadowOam[i].attr0 = ATTR0_HIDE;
+    }
+    plat_clear_bg();
+    oamHigh = OAM_COUNT;
+    commitPending = 1;
+}
+
+void plat_clear_bg(void) {
+    // Point every visible map entry at the blank tile
+    u32 blank = BLANK_TILE | (BLANK_TILE << 16);
+    DMA3COPY(&blank, shadowMap, DMA_SRC_FIXED | DMA32 | (sizeof(shadowMap) / 4));
+}
+
+void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal) {
+    if (tx < 0 || tx >= GBA_TILES_W || ty < 0 || ty >= GBA_TILES_H) return;
+
+    shadowMap[ty][tx] = (tileIndex & 0x3FF) | ATTR2_PAL(pal);
+}
+
+void plat_put_tile_run(int tx, int ty, const uint16_t* tiles, int count, uint8_t pal) {
+    // One clip for the whole run, then straight stores into the shadow map
+    if (ty < 0 || ty >= GBA_TILES_H || count <= 0) return;
+    if (tx < 0) {
+        tiles -= tx;
+        count += tx;
+        tx = 0;
+    }
+    if (tx + count > GBA_TILES_W) count = GBA_TILES_W - tx;
+
+    u16 attr = ATTR2_PAL(pal);
+    u16* entry = &shadowMap[ty][tx];
+    for (int i = 0; i < count; i++) {
+        if (tiles[i] != TILE_NONE) entry[i] = (tiles[i] & 0x3FF) | attr;
+    }
+}
+
+void plat_put_tile_rect(int tx, int ty, int w, int h, const uint16_t* tiles, uint8_t pal) {
+    for (int y = 0; y < h; y++) {
+        plat_put_tile_run(tx, ty + y, tiles + y * w, w, pal);
+    }
+}
+
+void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
+    if (id < 0 || id >= OAM_COUNT) return;
+
+    // 8x8 square, 4bpp
+    if (id >= oamHigh) oamHigh = id + 1;
+    shadowOam[id].attr0 = py & 0xFF;
+    shadowOam[id].attr1 = px & 0x1FF;
+    shadowOam[id].attr2 = (tileIndex & 0x3FF) | ATTR2_PAL(pal);
+}
+
+void plat_sprite_hide(int id) {
+    if (id < 0 || id >= OAM_COUNT) return;
+
+    if (id >= oamHigh) oamHigh = id + 1;
+    shadowOam[id].attr0 = ATTR0_HIDE;
+}
+
+void plat_present(void) {
+    // Hand the finished shadow copies to the next VBlank
+    oamUploadBytes = oamHigh * sizeof(ObjAttr);
+    commitPending = 1;
+}
+
+int plat_oam_bytes(void) {
+    return oamUploadBytes;
+}
+
+void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTilesLen,
+                      const uint16_t* objPal, const uint8_t* objTiles, int objTilesLen) {
+    // Load background palette
+    if (bgPal) {
+        DMA3COPY(bgPal, BG_PAL, DMA16 | 16); // 16 colors
+    }
+
+    // Load background tiles (the blank tile at the end of the charblock is kept)
+    if (bgTiles && bgTilesLen <= BLANK_TILE * TILE_WORDS * 4) {
+        DMA3COPY(bgTiles, BG_CHARBLOCK, DMA32 | (bgTilesLen / 4));
+    }
+
+    // Load sprite palette
+    if (objPal) {
+        DMA3COPY(objPal, OBJ_PAL, DMA16 | 16); // 16 colors
+    }
+
+    // Load sprite tiles
+    if (objTiles) {
+        DMA3COPY(objTiles, OBJ_CHARBLOCK, DMA32 | (objTilesLen / 4));
+    }
+}
@@ -0,0 +1,118 @@
+// GBA Mode 3 video backend - software-drawn 8x8 cells in the 240x160 bitmap
+#include <gba.h>
+#include "platform.h"
+#include "gba_video.h"
+#include "gba_fill.h"
+
+// Screen buffer for Mode 3
+static volatile u16* const videoBuffer = (u16*)0x06000000;
+
+// Dirty-tile tracking: drawing calls only record the colour each 8x8 cell
+// should have this frame; plat_present writes the cells that differ from
+// what is already in VRAM, so a typical frame touches a handful of cells
+// instead of the whole 38,400-pixel screen.
+static u16 cellNext[GBA_TILES_H][GBA_TILES_W];  // Colour requested this frame
+static u16 cellShown[GBA_TILES_H][GBA_TILES_W]; // Colour currently in VRAM
+
+// Fill one 8x8 cell with a solid colour, two pixels per store
+static void fill_cell(int tx, int ty, u16 color) {
+    gba_fill_cell16(&videoBuffer[(ty * GBA_TILE_PX) * GBA_SCREEN_W + tx * GBA_TILE_PX],
+                    color | (color << 16));
+}
+
+// Sprites are painted into whole cells (see plat_sprite_set)
+const int gbaSpriteSnap = 1;
+
+void gba_video_init(void) {
+    // Mode 3: bitmap mode for simplicity
+    REG_DISPCNT = MODE_3 | BG2_ON;
+    
+    // Start from a known black screen so the cell maps match VRAM
+    DMA3COPY(&(u16){0}, videoBuffer, DMA_SRC_FIXED | DMA16 | (GBA_SCREEN_W*GBA_SCREEN_H));
+}
+
+void gba_video_vblank(void) {
+    // Mode 3 draws straight into VRAM from plat_present
+}
+
+void plat_clear_bg(void) {
+    // Clear screen to black - only the 600-entry cell map, VRAM is diffed in plat_present
+    DMA3COPY(&(u32){0}, cellNext, DMA_SRC_FIXED | DMA32 | (sizeof(cellNext) / 4));
+}
+
+// Solid colour standing in for each palette bank until real tiles exist
+static u16 pal_color(uint8_t pal) {
+    switch (pal) {
+        case 1: return RGB5(31, 0, 0);   // Red
+        case 3: return RGB5(0, 31, 0);   // Green
+        default: return RGB5(31, 31, 31); // White
+    }
+}
+
+void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal) {
+    // Simple tile drawing using Mode 3
+    if (tx < 0 || tx >= GBA_TILES_W || ty < 0 || ty >= GBA_TILES_H) return;
+    
+    cellNext[ty][tx] = pal_color(pal);
+}
+
+void plat_put_tile_run(int tx, int ty, const uint16_t* tiles, int count, uint8_t pal) {
+    // One clip and one colour lookup for the whole run
+    if (ty < 0 || ty >= GBA_TILES_H || count <= 0) return;
+    if (tx < 0) {
+        tiles -= tx;
+        count += tx;
+        tx = 0;
+    }
+    if (tx + count > GBA_TILES_W) count = GBA_TILES_W - tx;
+    
+    u16 color = pal_color(pal);
+    u16* cell = &cellNext[ty][tx];
+    for (int i = 0; i < count; i++) {
+        if (tiles[i] != TILE_NONE) cell[i] = color;
+    }
+}
+
+void plat_put_tile_rect(int tx, int ty, int w, int h, const uint16_t* tiles, uint8_t pal) {
+    for (int y = 0; y < h; y++) {
+        plat_put_tile_run(tx, ty + y, tiles + y * w, w, pal);
+    }
+}
+
+void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
+    // Simple sprite drawing using Mode 3 - sprites snap to the nearest 8x8 cell
+    int tx = (px + GBA_TILE_PX / 2) >> 3;
+    int ty = (py + GBA_TILE_PX / 2) >> 3;
+    if (tx < 0 || tx >= GBA_TILES_W || ty < 0 || ty >= GBA_TILES_H) return;
+    
+    cellNext[ty][tx] = pal_color(pal);
+}
+
+void plat_sprite_hide(int id) {
+    // Nothing to do in Mode 3
+}
+
+void plat_present(void) {
+    // Redraw only the cells whose colour changed since the last frame. This
+    // runs when rendering ends, not in VBlank: it cuts VRAM writes, but a
+    // cell filled while the display is scanning it can still tear
+    for (int ty = 0; ty < GBA_TILES_H; ty++) {
+        for (int tx = 0; tx < GBA_TILES_W; tx++) {
+            u16 color = cellNext[ty][tx];
+            if (color != cellShown[ty][tx]) {
+                fill_cell(tx, ty, color);
+                cellShown[ty][tx] = color;
+            }
+        }
+    }
+}
+
+int plat_oam_bytes(void) {
+    // No OAM in Mode 3
+    return 0;
+}
+
+void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTilesLen,
+                      const uint16_t* objPal, const uint8_t* objTiles, int objTilesLen) {
+    // No assets needed for simple Mode 3 version
+}
@@ -0,0 +1,144 @@
+// GBA Mode 4 video backend - 8bpp paletted bitmap with two pages
+// Drawing always goes to the hidden page and the VBlank interrupt flips
+// pages, so a frame is never shown half drawn. Cells are diffed per page
+// like the Mode 3 backend, and each pixel is one byte instead of two.
+#include <gba.h>
+#include "platform.h"
+#include "gba_video.h"
+#include "gba_fill.h"
+
+// Page buffers and display control
+#define PAGE0           ((u32*)0x06000000)
+#define PAGE1           ((u32*)0x0600A000)
+#define BG_PAL          ((u16*)0x05000000)
+#define DCNT_PAGE       (1 << 4)
+#define ROW_WORDS       (GBA_SCREEN_W / 4)  // 4 pixels per word
+
+// Palette indices for the solid placeholder cells
+#define IDX_BLACK       0
+#define IDX_RED         1
+#define IDX_WHITE       2
+#define IDX_GREEN       3
+
+// Cell colours requested this frame and what each page currently holds
+static u8 cellNext[GBA_TILES_H][GBA_TILES_W] __attribute__((aligned(4)));
+static u8 pageCells[2][GBA_TILES_H][GBA_TILES_W];
+static int backPage = 1;                 // Page being drawn (the hidden one)
+static volatile int flipPending;
+
+// Fill one 8x8 cell of a page with a palette index, four pixels per store
+static void fill_cell(u32* page, int tx, int ty, u8 index) {
+    gba_fill_cell8(page + (ty * GBA_TILE_PX) * ROW_WORDS + tx * (GBA_TILE_PX / 4),
+                   index * 0x01010101);
+}
+
+// Palette index standing in for each palette bank until real tiles exist
+static u8 pal_index(uint8_t pal) {
+    switch (pal) {
+        case 1: return IDX_RED;
+        case 3: return IDX_GREEN;
+        default: return IDX_WHITE;
+    }
+}
+
+// Sprites are painted into whole cells (see plat_sprite_set)
+const int gbaSpriteSnap = 1;
+
+void gba_video_init(void) {
+    // Mode 4: paletted bitmap, page 0 shown first
+    REG_DISPCNT = MODE_4 | BG2_ON;
+
+    BG_PAL[IDX_BLACK] = RGB5(0, 0, 0);
+    BG_PAL[IDX_RED] = RGB5(31, 0, 0);
+    BG_PAL[IDX_WHITE] = RGB5(31, 31, 31);
+    BG_PAL[IDX_GREEN] = RGB5(0, 31, 0);
+
+    // Both pages start black so the cell maps match VRAM
+    DMA3COPY(&(u32){0}, PAGE0, DMA_SRC_FIXED | DMA32 | (GBA_SCREEN_W * GBA_SCREEN_H / 4));
+    DMA3COPY(&(u32){0}, PAGE1, DMA_SRC_FIXED | DMA32 | (GBA_SCREEN_W * GBA_SCREEN_H / 4));
+    backPage = 1;
+}
+
+void gba_video_vblank(void) {
+    // Flip only while the screen is not being drawn
+    if (!flipPending) return;
+
+    REG_DISPCNT ^= DCNT_PAGE;
+    backPage ^= 1;
+    flipPending = 0;
+}
+
+void plat_clear_bg(void) {
+    // Clear screen to black - only the cell map, pages are diffed in plat_present
+    DMA3COPY(&(u32){0}, cellNext, DMA_SRC_FIXED | DMA32 | (sizeof(cellNext) / 4));
+}
+
+void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal) {
+    if (tx < 0 || tx >= GBA_TILES_W || ty < 0 || ty >= GBA_TILES_H) return;
+
+    cellNext[ty][tx] = pal_index(pal);
+}
+
+void plat_put_tile_run(int tx, int ty, const uint16_t* tiles, int count, uint8_t pal) {
+    // One clip and one colour lookup for the whole run
+    if (ty < 0 || ty >= GBA_TILES_H || count <= 0) return;
+    if (tx < 0) {
+        tiles -= tx;
+        count += tx;
+        tx = 0;
+    }
+    if (tx + count > GBA_TILES_W) count = GBA_TILES_W - tx;
+
+    u8 index = pal_index(pal);
+    u8* cell = &cellNext[ty][tx];
+    for (int i = 0; i < count; i++) {
+        if (tiles[i] != TILE_NONE) cell[i] = index;
+    }
+}
+
+void plat_put_tile_rect(int tx, int ty, int w, int h, const uint16_t* tiles, uint8_t pal) {
+    for (int y = 0; y < h; y++) {
+        plat_put_tile_run(tx, ty + y, tiles + y * w, w, pal);
+    }
+}
+
+void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
+    // Sprites snap to the nearest 8x8 cell
+    int tx = (px + GBA_TILE_PX / 2) >> 3;
+    int ty = (py + GBA_TILE_PX / 2) >> 3;
+    if (tx < 0 || tx >= GBA_TILES_W || ty < 0 || ty >= GBA_TILES_H) return;
+
+    cellNext[ty][tx] = pal_index(pal);
+}
+
+void plat_sprite_hide(int id) {
+    // Nothing to do in Mode 4
+}
+
+void plat_present(void) {
+    // Bring the hidden page up to date - only cells that differ from what
+    // that page last held - then ask the next VBlank to show it
+    u32* page = backPage ? PAGE1 : PAGE0;
+    u8 (*shown)[GBA_TILES_W] = pageCells[backPage];
+
+    for (int ty = 0; ty < GBA_TILES_H; ty++) {
+        for (int tx = 0; tx < GBA_TILES_W; tx++) {
+            u8 index = cellNext[ty][tx];
+            if (index != shown[ty][tx]) {
+                fill_cell(page, tx, ty, index);
+                shown[ty][tx] = index;
+            }
+        }
+    }
+    flipPending = 1;
+}
+
+int plat_oam_bytes(void) {
+    // No OAM in Mode 4
+    return 0;
+}
+
+void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTilesLen,
+                      const uint16_t* objPal, const uint8_t* objTiles, int objTilesLen) {
+    // No assets needed for the solid-cell Mode 4 version
+}
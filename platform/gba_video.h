@@ -0,0 +1,21 @@
+// Internal interface between the GBA platform core (gba.c) and the
+// selectable GBA video backends (gba_mode3.c, gba_mode0.c, gba_mode4.c)
+
+#pragma once
+#include <gba.h>
+
+// GBA-specific constants
+#define GBA_TILES_W 30
+#define GBA_TILES_H 20
+#define GBA_TILE_PX 8
+#define GBA_SCREEN_W 240
+#define GBA_SCREEN_H 160
+
+// Non-zero if this backend's plat_sprite_set rounds to whole cells
+extern const int gbaSpriteSnap;
+
+// Set up display mode and VRAM - called from plat_init after IRQs are enabled
+void gba_video_init(void);
+
+// Called from the VBlank interrupt after input is latched
+void gba_video_vblank(void);
@@ -0,0 +1,377 @@
+// Headless host platform implementation for Snake game
+// Renders into an in-memory framebuffer and replays scripted input so the
+// core can be run (and profiled) on a Linux box at full speed.
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "platform.h"
+#include "host.h"
+#include "input_ring.h"
+#include "mixer.h"
+#include "sfx.h"
+
+// Host-specific constants
+#define HOST_TILE_PX 8
+#define HOST_TILES_W (HOST_SCREEN_W / HOST_TILE_PX)
+#define HOST_TILES_H (HOST_SCREEN_H / HOST_TILE_PX)
+#define HOST_DEFAULT_FRAMES 1000000
+#define HOST_MAX_SCRIPT 65536
+#define HOST_FRAME_NS 16742706     // One GBA frame (59.73 Hz) in nanoseconds
+
+#define RGB15(r, g, b) ((uint16_t)((r) | ((g) << 5) | ((b) << 10)))
+
+// In-memory screen buffer (same RGB555 layout as GBA Mode 3)
+static uint16_t frameBuffer[HOST_SCREEN_H * HOST_SCREEN_W];
+
+// Scripted input
+static const uint32_t* script;
+static int script_len;
+static int script_loop;
+static uint32_t script_storage[HOST_MAX_SCRIPT];
+
+// Input "latched" at each simulated VBlank, drained by plat_buttons
+static InputRing input_ring;
+static uint16_t held_keys;
+static uint32_t input_frame;
+
+// Frame timing
+static uint32_t frame_count;
+static uint32_t frame_limit = HOST_DEFAULT_FRAMES;
+static struct timespec start_time;
+
+// Highest sprite id touched this frame, reported as OAM traffic
+static int sprite_high;
+static int oam_bytes;
+
+// Audio: one block mixed per frame, appended to SNAKE_WAV when set
+static Mixer mixer;
+static int8_t audio_block[MIX_FRAME_SAMPLES];
+static FILE* wav_file;
+static uint32_t wav_samples;
+
+// Save file (SNAKE_SAVE), nothing is persisted when unset
+static const char* save_path;
+
+// Load a script file: one hex Buttons mask per line, '#' starts a comment
+static int load_script_file(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "host: cannot open input script %s\n", path);
+        return 0;
+    }
+
+    char line[64];
+    int count = 0;
+    while (count < HOST_MAX_SCRIPT && fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        script_storage[count++] = (uint32_t)strtoul(line, NULL, 16);
+    }
+    fclose(f);
+
+    host_set_script(script_storage, count, 1);
+    return count;
+}
+
+// Built-in workload: start a game, then keep turning so the snake covers the board
+static uint32_t default_input(uint32_t frame) {
+    static const uint32_t turns[4] = { BTN_DOWN, BTN_LEFT, BTN_UP, BTN_RIGHT };
+
+    if (frame % 1024 == 0) return BTN_START;
+    if (frame % 37 == 0) return turns[(frame / 37) & 3];
+    return 0;
+}
+
+// Scripted key state for a frame
+static uint32_t script_input(uint32_t frame) {
+    if (!script) return default_input(frame);
+    if (script_len <= 0) return 0;
+    if (frame >= (uint32_t)script_len) {
+        if (!script_loop) return 0;
+        frame %= (uint32_t)script_len;
+    }
+    return script[frame];
+}
+
+// Little-endian field writers for the WAV header
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = v; p[1] = v >> 8;
+}
+
+// 44-byte header for 8-bit mono PCM at MIX_RATE
+static void wav_header(uint8_t* h, uint32_t samples) {
+    memcpy(h, "RIFF", 4);
+    put_u32(h + 4, 36 + samples);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_u32(h + 16, 16);
+    put_u16(h + 20, 1);             // PCM
+    put_u16(h + 22, 1);             // Mono
+    put_u32(h + 24, MIX_RATE);
+    put_u32(h + 28, MIX_RATE);      // Bytes per second
+    put_u16(h + 32, 1);             // Block align
+    put_u16(h + 34, 8);             // Bits per sample
+    memcpy(h + 36, "data", 4);
+    put_u32(h + 40, samples);
+}
+
+// Rewrite the header with the final length and close the file
+static void wav_close(void) {
+    if (!wav_file) return;
+
+    uint8_t header[44];
+    wav_header(header, wav_samples);
+    fseek(wav_file, 0, SEEK_SET);
+    fwrite(header, 1, sizeof(header), wav_file);
+    fclose(wav_file);
+    wav_file = NULL;
+}
+
+static void wav_open(const char* path) {
+    wav_file = fopen(path, "wb");
+    if (!wav_file) {
+        fprintf(stderr, "host: cannot create %s\n", path);
+        return;
+    }
+
+    uint8_t header[44];
+    wav_header(header, 0);
+    fwrite(header, 1, sizeof(header), wav_file);
+    wav_samples = 0;
+    atexit(wav_close);
+}
+
+// Mix this frame's audio block, as the GBA does for its DMA buffer. With
+// no WAV to write, silent frames are skipped so the unthrottled loop spends
+// no time there; snake-bench never calls it and measures the core alone
+void plat_audio(void) {
+    if (!wav_file && !mixer_active(&mixer)) return;
+    mixer_mix(&mixer, audio_block, MIX_FRAME_SAMPLES);
+    if (!wav_file) return;
+
+    // WAV 8-bit PCM is unsigned
+    uint8_t pcm[MIX_FRAME_SAMPLES];
+    for (int i = 0; i < MIX_FRAME_SAMPLES; i++) {
+        pcm[i] = (uint8_t)(audio_block[i] ^ 0x80);
+    }
+    fwrite(pcm, 1, sizeof(pcm), wav_file);
+    wav_samples += MIX_FRAME_SAMPLES;
+}
+
+static void report(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double secs = (now.tv_sec - start_time.tv_sec) +
+                  (now.tv_nsec - start_time.tv_nsec) / 1e9;
+    fprintf(stderr, "host: %u frames in %.3f s (%.0f fps)\n",
+            frame_count, secs, secs > 0 ? frame_count / secs : 0.0);
+}
+
+// Initialize host "hardware"
+void plat_init(void) {
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+    memset(&input_ring, 0, sizeof(input_ring));
+    held_keys = 0;
+    frame_count = 0;
+
+    const char* frames = getenv("SNAKE_FRAMES");
+    if (frames) frame_limit = (uint32_t)strtoul(frames, NULL, 0);
+
+    const char* input = getenv("SNAKE_INPUT");
+    if (input) load_script_file(input);
+
+    mixer_init(&mixer);
+    sfx_init();
+    save_path = getenv("SNAKE_SAVE");
+    const char* wav = getenv("SNAKE_WAV");
+    if (wav && !wav_file) wav_open(wav);
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+}
+
+void plat_vblank(void) {
+    // Unthrottled - just count frames and stop once the limit is reached
+    if (frame_limit && frame_count >= frame_limit) {
+        report();
+        exit(0);
+    }
+    frame_count++;
+
+    // Simulated VBlank interrupt: latch this frame's scripted keys
+    input_ring_push(&input_ring, frame_count, script_input(frame_count - 1));
+}
+
+uint32_t plat_buttons(void) {
+    // Same drain-and-merge as the interrupt-driven console backends
+    if (!input_ring_drain(&input_ring, &held_keys, &input_frame)) {
+        input_frame = frame_count;
+    }
+    return held_keys;
+}
+
+uint32_t plat_frame(void) {
+    return frame_count;
+}
+
+uint32_t plat_input_frame(void) {
+    return input_frame;
+}
+
+void plat_clear_bg(void) {
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+}
+
+// Solid colour standing in for each palette bank (matches the GBA Mode 3 backend)
+static uint16_t pal_color(uint8_t pal) {
+    switch (pal) {
+        case 1: return RGB15(31, 0, 0);   // Red
+        case 3: return RGB15(0, 31, 0);   // Green
+        default: return RGB15(31, 31, 31); // White
+    }
+}
+
+void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal) {
+    if (tx < 0 || tx >= HOST_TILES_W || ty < 0 || ty >= HOST_TILES_H) return;
+
+    int px = tx * HOST_TILE_PX;
+    int py = ty * HOST_TILE_PX;
+    uint16_t color = pal_color(pal);
+
+    for (int y = 0; y < HOST_TILE_PX; y++) {
+        for (int x = 0; x < HOST_TILE_PX; x++) {
+            frameBuffer[(py + y) * HOST_SCREEN_W + (px + x)] = color;
+        }
+    }
+}
+
+void plat_put_tile_run(int tx, int ty, const uint16_t* tiles, int count, uint8_t pal) {
+    if (ty < 0 || ty >= HOST_TILES_H || count <= 0) return;
+    if (tx < 0) {
+        tiles -= tx;
+        count += tx;
+        tx = 0;
+    }
+    if (tx + count > HOST_TILES_W) count = HOST_TILES_W - tx;
+
+    for (int i = 0; i < count; i++) {
+        if (tiles[i] != TILE_NONE) plat_put_tile(tx + i, ty, tiles[i], pal);
+    }
+}
+
+void plat_put_tile_rect(int tx, int ty, int w, int h, const uint16_t* tiles, uint8_t pal) {
+    for (int y = 0; y < h; y++) {
+        plat_put_tile_run(tx, ty + y, tiles + y * w, w, pal);
+    }
+}
+
+void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
+    if (id < 0 || id >= 128) return;
+    if (id >= sprite_high) sprite_high = id + 1;
+    uint16_t color = pal_color(pal);
+
+    // Clip against the screen edges (sprites may sit partly off screen)
+    for (int y = 0; y < HOST_TILE_PX; y++) {
+        for (int x = 0; x < HOST_TILE_PX; x++) {
+            if ((unsigned)(px + x) < HOST_SCREEN_W && (unsigned)(py + y) < HOST_SCREEN_H) {
+                frameBuffer[(py + y) * HOST_SCREEN_W + (px + x)] = color;
+            }
+        }
+    }
+}
+
+void plat_sprite_hide(int id) {
+    // Sprites are drawn straight into the framebuffer
+    if (id < 0 || id >= 128) return;
+    if (id >= sprite_high) sprite_high = id + 1;
+}
+
+void plat_present(void) {
+    // Nothing to commit - account for the OAM prefix a hardware backend would upload
+    oam_bytes = sprite_high * 8;
+    sprite_high = 0;
+}
+
+int plat_oam_bytes(void) {
+    return oam_bytes;
+}
+
+GfxInfo plat_gfx_info(void) {
+    GfxInfo info = {
+        .tiles_w = HOST_TILES_W,
+        .tiles_h = HOST_TILES_H,
+        .tile_px = HOST_TILE_PX
+    };
+    return info;
+}
+
+void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTilesLen,
+                      const uint16_t* objPal, const uint8_t* objTiles, int objTilesLen) {
+    // No assets on the host
+}
+
+uint32_t plat_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+
+uint32_t plat_cycles_per_frame(void) {
+    return HOST_FRAME_NS;
+}
+
+int plat_save_read(uint8_t* buf, int len) {
+    if (!save_path) return 0;
+
+    FILE* f = fopen(save_path, "rb");
+    if (!f) return 0;
+    int n = fread(buf, 1, len, f);
+    fclose(f);
+    return n;
+}
+
+void plat_save_write(const uint8_t* buf, int len) {
+    if (!save_path) return;
+
+    FILE* f = fopen(save_path, "wb");
+    if (!f) {
+        fprintf(stderr, "host: cannot write %s\n", save_path);
+        return;
+    }
+    fwrite(buf, 1, len, f);
+    fclose(f);
+}
+
+void plat_beep_ok(void) {
+    plat_sfx(SFX_EAT);
+}
+
+void plat_beep_hit(void) {
+    plat_sfx(SFX_HIT);
+}
+
+void plat_sfx(uint8_t id) {
+    sfx_play(&mixer, id);
+}
+
+// Host extras
+void host_set_script(const uint32_t* masks, int count, int loop) {
+    script = masks;
+    script_len = count;
+    script_loop = loop;
+}
+
+void host_set_frame_limit(uint32_t frames) {
+    frame_limit = frames;
+}
+
+uint32_t host_frame_count(void) {
+    return frame_count;
+}
+
+const uint16_t* host_framebuffer(void) {
+    return frameBuffer;
+}
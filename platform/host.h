@@ -0,0 +1,26 @@
+// Headless host platform extras (PLATFORM=host only)
+// Lets tools drive the host backend without going through environment variables
+
+#pragma once
+#include <stdint.h>
+
+// Host screen geometry - GBA layout by default, NDS layout with -DHOST_NDS
+#ifdef HOST_NDS
+#define HOST_SCREEN_W 256
+#define HOST_SCREEN_H 192
+#else
+#define HOST_SCREEN_W 240
+#define HOST_SCREEN_H 160
+#endif
+
+// Scripted input: one Buttons mask per frame, optionally looped
+void host_set_script(const uint32_t* masks, int count, int loop);
+
+// Stop after this many frames (0 = run forever)
+void host_set_frame_limit(uint32_t frames);
+
+// Frames elapsed since plat_init
+uint32_t host_frame_count(void);
+
+// In-memory RGB555 framebuffer, HOST_SCREEN_W x HOST_SCREEN_H
+const uint16_t* host_framebuffer(void);
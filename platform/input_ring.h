@@ -0,0 +1,69 @@
+// Lock-free single-producer / single-consumer input buffer shared by the
+// platform backends. The VBlank interrupt (producer) latches the raw key
+// state once per frame; plat_buttons (consumer) drains it from the main
+// loop, so a frame whose rendering overruns still sees every latched sample.
+
+#pragma once
+#include <stdint.h>
+
+#define INPUT_RING_SIZE 16   // Power of two
+
+// Compiler barrier: only head/tail are volatile, so the sample accesses
+// must not be moved across the index that publishes or consumes them
+#define INPUT_RING_BARRIER() __asm__ volatile("" ::: "memory")
+
+typedef struct {
+    uint32_t frame;          // VBlank count when the keys were latched
+    uint16_t keys;           // Raw platform key bits, 1 = held
+} InputSample;
+
+typedef struct {
+    InputSample samples[INPUT_RING_SIZE];
+    volatile uint32_t head;  // Written only by the producer
+    volatile uint32_t tail;  // Written only by the consumer
+} InputRing;
+
+// Producer side (interrupt) - drops the sample if the consumer is a full ring behind
+static inline void input_ring_push(InputRing* ring, uint32_t frame, uint16_t keys) {
+    uint32_t head = ring->head;
+    if (head - ring->tail >= INPUT_RING_SIZE) return;
+
+    ring->samples[head & (INPUT_RING_SIZE - 1)].frame = frame;
+    ring->samples[head & (INPUT_RING_SIZE - 1)].keys = keys;
+    INPUT_RING_BARRIER();
+    ring->head = head + 1;   // Publish only after the sample is written
+}
+
+// Consumer side (main loop) - returns 0 when no sample is pending
+static inline int input_ring_pop(InputRing* ring, InputSample* out) {
+    uint32_t tail = ring->tail;
+    if (tail == ring->head) return 0;
+    INPUT_RING_BARRIER();    // Read the sample only after seeing it published
+
+    *out = ring->samples[tail & (INPUT_RING_SIZE - 1)];
+    INPUT_RING_BARRIER();    // ...and before handing the slot back
+    ring->tail = tail + 1;
+    return 1;
+}
+
+// Drain everything pending: held keys are OR-merged so a press that came and
+// went while the main loop was busy is still seen, and *frame receives the
+// stamp of the oldest sample. Returns the number of samples consumed.
+// The merge is one held mask, so a key released and pressed again within a
+// single drain reads as held throughout and the core sees one press edge,
+// not two - it takes a main loop frame overrunning by more than a VBlank
+// and a tap shorter than that to hit it.
+static inline int input_ring_drain(InputRing* ring, uint16_t* keys, uint32_t* frame) {
+    InputSample sample;
+    int count = 0;
+
+    while (input_ring_pop(ring, &sample)) {
+        if (count == 0) {
+            *keys = 0;
+            *frame = sample.frame;
+        }
+        *keys |= sample.keys;
+        count++;
+    }
+    return count;
+}
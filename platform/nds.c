@@ -1,11 +1,36 @@
 // NDS platform implementation for Snake game
 #include <nds.h>
+#include <fat.h>
+#include <stdio.h>
 #include "platform.h"
+#include "input_ring.h"
+#include "sfx.h"
 
 // NDS-specific constants
 #define NDS_TILES_W 32
 #define NDS_TILES_H 24
 #define NDS_TILE_PX 8
+#define NDS_FRAME_CYCLES 560190   // Bus cycles per frame: 263 lines x 2130
+#define NDS_SAVE_PATH "/snake.sav"
+
+// Input latched by the VBlank interrupt
+static InputRing inputRing;
+static volatile uint32_t vblankCount;
+static uint16_t heldKeys;       // Last merged key state, kept if no new sample arrived
+static uint32_t inputFrame;     // Stamp of the oldest sample merged by plat_buttons
+
+// Sound effects pre-rendered by the core mixer; the ARM7 mixes them in hardware
+static int8_t sfxPcm[SFX_COUNT][SFX_MAX_SAMPLES] __attribute__((aligned(32)));
+static int sfxLen[SFX_COUNT];
+
+// Save file on the card's FAT filesystem (unavailable on some loaders)
+static int fatReady;
+
+// VBlank interrupt: latch the ARM9-visible keypad bits (A/B/SELECT/START/D-pad/R/L)
+static void nds_vblank_isr(void) {
+    vblankCount++;
+    input_ring_push(&inputRing, vblankCount, ~REG_KEYINPUT & 0x03FF);
+}
 
 // Initialize NDS hardware
 void plat_init(void) {
@@ -26,16 +51,39 @@ void plat_init(void) {
     
     // Enable interrupts
     irqInit();
+    irqSet(IRQ_VBLANK, nds_vblank_isr);
     irqEnable(IRQ_VBLANK);
+    
+    // Profiling clock: cascaded timers 2/3 at the bus clock
+    cpuStartTiming(2);
+    
+    // Save storage - mounted once here so game_init's read does not wait on it
+    fatReady = fatInitDefault();
+    
+    // Render every effect once and flush it out of the data cache for the ARM7
+    soundEnable();
+    sfx_init();
+    for (int i = 0; i < SFX_COUNT; i++) {
+        sfxLen[i] = sfx_render(i, sfxPcm[i], SFX_MAX_SAMPLES) & ~3; // Sound DMA moves words
+    }
+    DC_FlushRange(sfxPcm, sizeof(sfxPcm));
 }
 
 void plat_vblank(void) {
     swiWaitForVBlank();
 }
 
+void plat_audio(void) {
+    // Effects play from sfxPcm on the ARM7's channels - nothing to mix
+}
+
 uint32_t plat_buttons(void) {
-    scanKeys();
-    u16 keys = keysHeld();
+    // Held state - the core does its own edge detection. Everything latched
+    // since the last call is merged, so an overrunning frame loses no press.
+    if (!input_ring_drain(&inputRing, &heldKeys, &inputFrame)) {
+        inputFrame = vblankCount;
+    }
+    u16 keys = heldKeys;
     
     uint32_t buttons = 0;
     if (keys & KEY_UP)    buttons |= BTN_UP;
@@ -50,6 +98,14 @@ uint32_t plat_buttons(void) {
     return buttons;
 }
 
+uint32_t plat_frame(void) {
+    return vblankCount;
+}
+
+uint32_t plat_input_frame(void) {
+    return inputFrame;
+}
+
 void plat_clear_bg(void) {
     // Clear BG0 tilemap
     u16* bgMap = bgGetMapPtr(0);
@@ -65,6 +121,29 @@ void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal) {
     bgMap[ty * 32 + tx] = tileIndex | (pal << 12);
 }
 
+void plat_put_tile_run(int tx, int ty, const uint16_t* tiles, int count, uint8_t pal) {
+    // One clip and one map lookup for the whole run
+    if (ty < 0 || ty >= 32 || count <= 0) return;
+    if (tx < 0) {
+        tiles -= tx;
+        count += tx;
+        tx = 0;
+    }
+    if (tx + count > 32) count = 32 - tx;
+    
+    u16* entry = bgGetMapPtr(0) + ty * 32 + tx;
+    u16 attr = pal << 12;
+    for (int i = 0; i < count; i++) {
+        if (tiles[i] != TILE_NONE) entry[i] = tiles[i] | attr;
+    }
+}
+
+void plat_put_tile_rect(int tx, int ty, int w, int h, const uint16_t* tiles, uint8_t pal) {
+    for (int y = 0; y < h; y++) {
+        plat_put_tile_run(tx, ty + y, tiles + y * w, w, pal);
+    }
+}
+
 void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
     if (id < 0 || id >= 128) return;
     
@@ -75,8 +154,8 @@ void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal) {
 void plat_sprite_hide(int id) {
     if (id < 0 || id >= 128) return;
     
-    oamSet(&oamMain, id, 0, 0, 0, 0, SpriteSize_8x8, SpriteColorFormat_16Color,
-           0, -1, false, false, false, false, false);
+    // Sets the hide bit - an oamSet with hide=false would leave it on screen
+    oamClearSprite(&oamMain, id);
 }
 
 void plat_present(void) {
@@ -84,6 +163,11 @@ void plat_present(void) {
     oamUpdate(&oamMain);
 }
 
+int plat_oam_bytes(void) {
+    // oamUpdate always copies the full 128-entry table
+    return 128 * 8;
+}
+
 GfxInfo plat_gfx_info(void) {
     GfxInfo info = {
         .tiles_w = NDS_TILES_W,
@@ -117,20 +201,45 @@ void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTiles
     }
 }
 
+uint32_t plat_cycles(void) {
+    return cpuGetTiming();
+}
+
+uint32_t plat_cycles_per_frame(void) {
+    return NDS_FRAME_CYCLES;
+}
+
+int plat_save_read(uint8_t* buf, int len) {
+    if (!fatReady) return 0;
+    
+    FILE* f = fopen(NDS_SAVE_PATH, "rb");
+    if (!f) return 0;
+    int n = fread(buf, 1, len, f);
+    fclose(f);
+    return n;
+}
+
+void plat_save_write(const uint8_t* buf, int len) {
+    // The core only calls this when the record changed, so each write is a real update
+    if (!fatReady) return;
+    
+    FILE* f = fopen(NDS_SAVE_PATH, "wb");
+    if (!f) return;
+    fwrite(buf, 1, len, f);
+    fclose(f);
+}
+
 void plat_beep_ok(void) {
-    // Simple beep using NDS sound
-    soundPlaySample(0, SoundFormat_8Bit, 440, 64, 64, 0, 0);
+    plat_sfx(SFX_EAT);
 }
 
 void plat_beep_hit(void) {
-    // Lower frequency beep
-    soundPlaySample(0, SoundFormat_8Bit, 220, 64, 64, 0, 0);
+    plat_sfx(SFX_HIT);
 }
 
-void plat_seed_random(uint32_t seed) {
-    srand(seed);
+void plat_sfx(uint8_t id) {
+    if (id >= SFX_COUNT || sfxLen[id] == 0) return;
+    
+    soundPlaySample(sfxPcm[id], SoundFormat_8Bit, sfxLen[id], MIX_RATE, 127, 64, false, 0);
 }
 
-uint32_t plat_random(void) {
-    return rand();
-}
@@ -25,6 +25,7 @@ typedef enum {
 typedef struct {
     int tiles_w, tiles_h;  // GBA: 30x20, NDS: 32x24
     int tile_px;           // 8 pixels per tile
+    int sprite_snap;       // Sprites snap to whole tiles (GBA bitmap modes) - no sub-tile motion
 } GfxInfo;
 
 // Platform initialization
@@ -34,16 +35,25 @@ void plat_init(void);             // Initialize video, IRQ, etc.
 void plat_vblank(void);           // Wait for VBlank
 
 // Input
-uint32_t plat_buttons(void);      // Returns bitmask of Buttons
+uint32_t plat_buttons(void);      // Returns bitmask of Buttons currently held
+                                  // (merges every sample latched by the VBlank IRQ since the last call)
+uint32_t plat_frame(void);        // VBlanks since plat_init
+uint32_t plat_input_frame(void);  // VBlank at which the oldest input merged by plat_buttons was latched
 
 // Background rendering
 void plat_clear_bg(void);         // Clear BG tilemap
 void plat_put_tile(int tx, int ty, uint16_t tileIndex, uint8_t pal); // Put BG tile
 
+// Batched BG tiles - clipped once per call, TILE_NONE entries leave the cell untouched
+#define TILE_NONE 0xFFFF
+void plat_put_tile_run(int tx, int ty, const uint16_t* tiles, int count, uint8_t pal);     // Horizontal run
+void plat_put_tile_rect(int tx, int ty, int w, int h, const uint16_t* tiles, uint8_t pal); // Row-major w x h block
+
 // Sprite rendering (for snake segments and food)
 void plat_sprite_set(int id, int px, int py, uint16_t tileIndex, uint8_t pal);     // Set sprite
 void plat_sprite_hide(int id);    // Hide sprite
 void plat_present(void);          // Commit OAM if needed
+int plat_oam_bytes(void);         // Bytes of OAM uploaded for the last presented frame (profiling)
 
 // Graphics info
 GfxInfo plat_gfx_info(void);      // Get screen dimensions
@@ -52,10 +62,16 @@ GfxInfo plat_gfx_info(void);      // Get screen dimensions
 void plat_load_assets(const uint16_t* bgPal, const uint8_t* bgTiles, int bgTilesLen,
                       const uint16_t* objPal, const uint8_t* objTiles, int objTilesLen);
 
-// Audio (optional)
-void plat_beep_ok(void);          // Play success sound
-void plat_beep_hit(void);         // Play collision sound
+// Audio (optional) - effects are mixed by core/mixer.c or played by the hardware
+void plat_beep_ok(void);          // Play success sound (SFX_EAT)
+void plat_beep_hit(void);         // Play collision sound (SFX_HIT)
+void plat_sfx(uint8_t id);        // Play any SfxId from core/sfx.h
+void plat_audio(void);            // Mix this frame's block after plat_vblank (no-op where hardware mixes)
+
+// Persistent storage - a small block of save memory (GBA: SRAM, NDS: file, host: SNAKE_SAVE)
+int plat_save_read(uint8_t* buf, int len);         // Bytes read, 0 if nothing is stored
+void plat_save_write(const uint8_t* buf, int len); // Only bytes that differ need to be written
 
-// Random number generation
-void plat_seed_random(uint32_t seed);
-uint32_t plat_random(void);       // Returns random number
+// Profiling - free-running counter (GBA: CPU cycles, NDS: bus cycles, host: nanoseconds)
+uint32_t plat_cycles(void);
+uint32_t plat_cycles_per_frame(void); // Counter ticks in one video frame
@@ -1,6 +1,5 @@
 #include <gba.h>
-#include <stdio.h>
-#include <stdlib.h>
+#include <stdint.h>
 
 // Screen dimensions
 #define SCREEN_W 240
@@ -33,6 +32,20 @@ static void fillRect(int x, int y, int w, int h, u16 color) {
     }
 }
 
+// Playfield background (black with grid lines and a border), composed once
+// in EWRAM by buildBackground and copied over the screen each frame
+#define GRID_COLOR RGB5(8, 8, 8)
+static u16 background[SCREEN_W * SCREEN_H] EWRAM_BSS __attribute__((aligned(4)));
+
+static void buildBackground(void) {
+    for (int y = 0; y < SCREEN_H; y++) {
+        for (int x = 0; x < SCREEN_W; x++) {
+            int line = (x & 7) == 0 || (y & 7) == 0 || x == SCREEN_W - 1 || y == SCREEN_H - 1;
+            background[y * SCREEN_W + x] = line ? GRID_COLOR : RGB5(0, 0, 0);
+        }
+    }
+}
+
 // Game constants
 #define GRID_W 30
 #define GRID_H 20
@@ -49,7 +62,7 @@ static int snake_len = 3;
 static int dir_x = 1;
 static int dir_y = 0;
 static Point food;
-static int score = 0;
+static u32 score = 0;       // Packed BCD (8 digits), see bcdAdd
 static int game_started = 0;
 static u8 grid[GRID_H][GRID_W]; // 0=empty, 1=snake, 2=food
 
@@ -67,9 +80,36 @@ static const u8 font_numbers[10][8] = {
     {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x11, 0x0E, 0x00}  // 9
 };
 
-// Simple RNG
+// Simple RNG - xorshift32, no libc rand() state or toolchain-specific sequence
+static u32 rngState = 1;
+
+static void seedRandom(u32 seed) {
+    rngState = seed ? seed : 1;
+}
+
+static u32 nextRandom(void) {
+    u32 x = rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return rngState = x;
+}
+
+// Uniform value in [lo, hi] - multiply-shift with rejection instead of the
+// biased rand() % n
 static int randRange(int lo, int hi) {
-    return lo + (rand() % (hi - lo + 1));
+    u32 range = hi - lo + 1;
+    uint64_t m = (uint64_t)nextRandom() * range;
+    u32 low = (u32)m;
+
+    if (low < range) {
+        u32 threshold = -range % range;
+        while (low < threshold) {
+            m = (uint64_t)nextRandom() * range;
+            low = (u32)m;
+        }
+    }
+    return lo + (int)(m >> 32);
 }
 
 // Clear grid
@@ -126,20 +166,27 @@ static int checkCollision(int x, int y) {
     return grid[y][x] == 1;
 }
 
-// Draw number on screen
-static void drawNumber(int x, int y, int number, u16 color) {
-    char str[16];
-    sprintf(str, "%d", number);
+// Packed BCD add - no divide instruction on the ARM7TDMI, so the score is
+// kept in decimal digits and drawing it is shift-and-mask only
+static u32 bcdAdd(u32 a, u32 b) {
+    u32 t1 = a + 0x06666666;
+    u32 t2 = t1 + b;
+    u32 carries = ~(t2 ^ t1 ^ b) & 0x11111110;
+    return t2 - ((carries >> 2) | (carries >> 3));
+}
+
+// Draw a packed BCD number on screen, without leading zeros
+static void drawNumber(int x, int y, u32 bcd, u16 color) {
+    int len = 8;
+    while (len > 1 && ((bcd >> ((len - 1) * 4)) & 0xF) == 0) len--;
     
-    for (int i = 0; str[i] != '\0'; i++) {
-        int digit = str[i] - '0';
-        if (digit >= 0 && digit <= 9) {
-            for (int py = 0; py < 8; py++) {
-                u8 line = font_numbers[digit][py];
-                for (int px = 0; px < 8; px++) {
-                    if (line & (0x80 >> px)) {
-                        putPixel(x + i * 8 + px, y + py, color);
-                    }
+    for (int i = 0; i < len; i++) {
+        int digit = (bcd >> ((len - 1 - i) * 4)) & 0xF;
+        for (int py = 0; py < 8; py++) {
+            u8 line = font_numbers[digit][py];
+            for (int px = 0; px < 8; px++) {
+                if (line & (0x80 >> px)) {
+                    putPixel(x + i * 8 + px, y + py, color);
                 }
             }
         }
@@ -148,19 +195,9 @@ static void drawNumber(int x, int y, int number, u16 color) {
 
 // Draw game screen
 static void drawGame(void) {
-    fillScreen(RGB5(0, 0, 0)); // Black background
-    
-    // Draw grid lines
-    for (int y = 0; y < SCREEN_H; y += 8) {
-        for (int x = 0; x < SCREEN_W; x++) {
-            putPixel(x, y, RGB5(8, 8, 8)); // Dark gray
-        }
-    }
-    for (int x = 0; x < SCREEN_W; x += 8) {
-        for (int y = 0; y < SCREEN_H; y++) {
-            putPixel(x, y, RGB5(8, 8, 8)); // Dark gray
-        }
-    }
+    // Restore the grid background in one 32-bit DMA instead of clearing
+    // the screen and plotting every grid pixel
+    DMA3COPY(background, videoBuffer, DMA32 | (SCREEN_W * SCREEN_H / 2));
     
     // Draw snake
     for (int i = 0; i < snake_len; i++) {
@@ -202,7 +239,10 @@ int main(void) {
     REG_DISPCNT = MODE_3 | BG2_ON;
     
     // Seed RNG
-    srand(0x12345678);
+    seedRandom(0x12345678);
+    
+    // Compose the playfield background once
+    buildBackground();
     
     int frames = 0;
     const int moveDelay = 8;
@@ -271,7 +311,7 @@ int main(void) {
                         snake_len++;
                         snake[snake_len - 1] = snake[snake_len - 2];
                     }
-                    score += 10;
+                    score = bcdAdd(score, 0x10);
                     spawnFood();
                 }
             }
@@ -0,0 +1,331 @@
+// Host batch simulator (PLATFORM=host only)
+//
+//   snake-batch [games] [threads] [ai|fuzz] [--check] [--cap frames]
+//
+// Plays `games` independent headless games on a pool of threads and reports
+// throughput plus the score/length distribution. Each game gets its own
+// Game, seed and input generator, and its sound/save hooks point at its
+// worker's counters, so nothing mutable is shared except the work queues.
+// Input is the autopilot (ai, default) or random presses from a per-game Rng
+// (fuzz); --check verifies the board invariants after every frame and stops
+// at the first violation with the seed that reproduces it.
+//
+// Scheduling is work stealing: every worker owns a contiguous range of game
+// indices and takes small chunks off its front; a worker that runs dry takes
+// the back half of the fullest other range. Results do not depend on the
+// thread count - compare the printed digest between runs.
+#define _POSIX_C_SOURCE 199309L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "game.h"
+#include "ai.h"
+#include "sfx.h"
+
+#define BATCH_SEED 0x12345678
+#define MAX_THREADS 256
+#define CHUNK_GAMES 4               // Games taken off the own range per lock
+#define DEFAULT_CAP 2000000         // Frames before a game counts as timed out
+#define SCORE_SLOTS (BOARD_CELLS + 1) // Histogram by food eaten
+
+typedef enum {
+    INPUT_AI,
+    INPUT_FUZZ
+} InputMode;
+
+// One worker's queue of game indices [next, end)
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t next, end;
+} Range;
+
+typedef struct {
+    // Setup
+    int id;
+    InputMode input;
+    int check;
+    uint32_t cap;
+
+    // Per-instance state, reused game after game
+    Game game;
+    Ai ai;
+    Rng input_rng;
+
+    // Results - touched only by the owning thread until it is joined
+    uint32_t games, won, died, timed_out, steals;
+    uint64_t frames, sfx_events, digest;
+    uint32_t max_len;
+    uint32_t scores[SCORE_SLOTS];
+    int failed;
+} Worker;
+
+static Range ranges[MAX_THREADS];
+static Worker* workers;
+static int worker_count;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Sound goes to the worker's counter; nothing is loaded or saved
+static void batch_sfx(void* ctx, uint8_t id) {
+    (void)id;
+    ((Worker*)ctx)->sfx_events++;
+}
+
+static const GameHooks batch_hooks = { batch_sfx, NULL, NULL };
+
+// Per-game seed - a pure function of the index so any game can be rerun alone
+static uint32_t game_seed_for(uint32_t index) {
+    uint32_t z = BATCH_SEED + index * 0x9E3779B9u;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+// Take the next chunk of our own range, or steal half of the fullest other one
+static int take_work(Worker* w, uint32_t* first, uint32_t* count) {
+    Range* own = &ranges[w->id];
+    pthread_mutex_lock(&own->lock);
+    if (own->next < own->end) {
+        *first = own->next;
+        *count = own->end - own->next < CHUNK_GAMES ? own->end - own->next : CHUNK_GAMES;
+        own->next += *count;
+        pthread_mutex_unlock(&own->lock);
+        return 1;
+    }
+    pthread_mutex_unlock(&own->lock);
+
+    for (;;) {
+        // Pick the fullest victim, then re-check under its lock
+        int victim = -1;
+        uint32_t best = 0;
+        for (int i = 0; i < worker_count; i++) {
+            if (i == w->id) continue;
+            pthread_mutex_lock(&ranges[i].lock);
+            uint32_t left = ranges[i].end - ranges[i].next;
+            pthread_mutex_unlock(&ranges[i].lock);
+            if (left > best) {
+                best = left;
+                victim = i;
+            }
+        }
+        if (victim < 0) return 0;
+
+        Range* r = &ranges[victim];
+        pthread_mutex_lock(&r->lock);
+        uint32_t left = r->end - r->next;
+        if (left == 0) {
+            pthread_mutex_unlock(&r->lock);
+            continue;
+        }
+        uint32_t half = (left + 1) / 2;
+        r->end -= half;
+        uint32_t stolen = r->end;
+        pthread_mutex_unlock(&r->lock);
+
+        // Keep the stolen range as our own so others can steal from it in turn
+        pthread_mutex_lock(&own->lock);
+        own->next = stolen;
+        own->end = stolen + half;
+        *first = own->next;
+        *count = half < CHUNK_GAMES ? half : CHUNK_GAMES;
+        own->next += *count;
+        pthread_mutex_unlock(&own->lock);
+        w->steals++;
+        return 1;
+    }
+}
+
+// Board invariants: grid, snake ring and free-cell set agree
+static const char* check_game(const Game* g) {
+    int grid_cells = 0;
+    for (int y = 0; y < BOARD_H; y++) {
+        grid_cells += __builtin_popcount(g->grid[y]);
+    }
+    if (grid_cells != g->snake_len) return "grid population != snake length";
+    if (g->free_count + g->snake_len != BOARD_CELLS) return "free cells + snake length != board";
+
+    SnakeIter it = game_snake_iter(g);
+    const Cell* seg;
+    while ((seg = game_snake_next(g, &it))) {
+        if (!game_grid_test(g, seg->x, seg->y)) return "segment missing from grid";
+    }
+    for (int i = 0; i < g->free_count; i++) {
+        int cell = g->free_cells[i];
+        if (g->free_index[cell] != i) return "free index out of step";
+        if (game_grid_test(g, cell % BOARD_W, cell / BOARD_W)) return "free cell under snake";
+    }
+    if (g->state == GAME_PLAYING && game_grid_test(g, g->food.x, g->food.y)) return "food under snake";
+    return NULL;
+}
+
+static uint32_t next_input(Worker* w) {
+    if (w->input == INPUT_AI) return ai_buttons(&w->ai, &w->game);
+
+    // Fuzz: a press on roughly one frame in four - sometimes START, otherwise
+    // a random direction (one in eight) or a greedy one towards the food, so snakes grow
+    uint32_t r = rng_next(&w->input_rng);
+    if ((r & 3) != 0) return 0;
+    if ((r >> 2) % 64 == 0) return BTN_START;
+    if (((r >> 8) & 7) == 0) return 1u << ((r >> 12) & 3);
+
+    const Game* g = &w->game;
+    const Cell* head = &g->snake[g->snake_head];
+    if ((r >> 14) & 1 && head->x != g->food.x) return head->x < g->food.x ? BTN_RIGHT : BTN_LEFT;
+    if (head->y != g->food.y) return head->y < g->food.y ? BTN_DOWN : BTN_UP;
+    return head->x < g->food.x ? BTN_RIGHT : BTN_LEFT;
+}
+
+static void play_game(Worker* w, uint32_t index) {
+    Game* g = &w->game;
+    uint32_t seed = game_seed_for(index);
+
+    game_init_hooks(g, &batch_hooks, w);
+    game_seed(g, seed);
+    ai_init(&w->ai);
+    rng_seed(&w->input_rng, ~seed);
+    game_update(g, BTN_START);
+
+    uint32_t f = 0;
+    while (f < w->cap && (g->state == GAME_PLAYING || g->state == GAME_PAUSED)) {
+        game_update(g, next_input(w));
+        f++;
+        if (w->check) {
+            const char* err = check_game(g);
+            if (err) {
+                fprintf(stderr, "batch: game %u (seed 0x%08X) frame %u: %s\n", index, seed, f, err);
+                w->failed = 1;
+                return;
+            }
+        }
+    }
+
+    w->games++;
+    w->frames += f;
+    if (g->state == GAME_WON) w->won++;
+    else if (g->state == GAME_OVER) w->died++;
+    else w->timed_out++;
+    if (g->snake_len > w->max_len) w->max_len = g->snake_len;
+    w->scores[g->score / FOOD_POINTS]++;
+
+    // Order-independent digest of every game's outcome
+    uint64_t h = ((uint64_t)index << 32 | (uint32_t)g->score) * 0x9E3779B97F4A7C15ull;
+    w->digest += h ^ ((uint64_t)f * 0xC2B2AE3D27D4EB4Full);
+}
+
+static void* worker_main(void* arg) {
+    Worker* w = arg;
+    uint32_t first, count;
+    while (!w->failed && take_work(w, &first, &count)) {
+        for (uint32_t i = 0; i < count && !w->failed; i++) {
+            play_game(w, first + i);
+        }
+    }
+    return NULL;
+}
+
+// Score at the given fraction of the sorted distribution
+static int percentile(const uint32_t* scores, uint32_t games, double p) {
+    uint32_t target = (uint32_t)(p * (games - 1));
+    uint32_t seen = 0;
+    for (int s = 0; s < SCORE_SLOTS; s++) {
+        seen += scores[s];
+        if (seen > target) return s * FOOD_POINTS;
+    }
+    return (SCORE_SLOTS - 1) * FOOD_POINTS;
+}
+
+int main(int argc, char** argv) {
+    uint32_t games = 256;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    InputMode input = INPUT_AI;
+    int check = 0;
+    uint32_t cap = DEFAULT_CAP;
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "ai") == 0) input = INPUT_AI;
+        else if (strcmp(argv[i], "fuzz") == 0) input = INPUT_FUZZ;
+        else if (strcmp(argv[i], "--check") == 0) check = 1;
+        else if (strcmp(argv[i], "--cap") == 0 && i + 1 < argc) cap = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (positional == 0) games = (uint32_t)strtoul(argv[i], NULL, 0), positional++;
+        else if (positional == 1) threads = atoi(argv[i]), positional++;
+        else {
+            fprintf(stderr, "usage: snake-batch [games] [threads] [ai|fuzz] [--check] [--cap frames]\n");
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if ((uint32_t)threads > games && games > 0) threads = (int)games;
+
+    // Even split up front; stealing evens out games of different lengths
+    worker_count = threads;
+    workers = calloc(threads, sizeof(Worker));
+    pthread_t tids[MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_init(&ranges[t].lock, NULL);
+        ranges[t].next = (uint32_t)((uint64_t)games * t / threads);
+        ranges[t].end = (uint32_t)((uint64_t)games * (t + 1) / threads);
+        workers[t].id = t;
+        workers[t].input = input;
+        workers[t].check = check;
+        workers[t].cap = cap;
+    }
+
+    double start = now_sec();
+    for (int t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, worker_main, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double elapsed = now_sec() - start;
+
+    // Merge the per-worker results
+    static uint32_t scores[SCORE_SLOTS];
+    uint32_t played = 0, won = 0, died = 0, timed_out = 0, steals = 0, max_len = 0;
+    uint64_t frames = 0, sfx_events = 0, digest = 0, score_sum = 0;
+    int failed = 0;
+    for (int t = 0; t < threads; t++) {
+        Worker* w = &workers[t];
+        played += w->games;
+        won += w->won;
+        died += w->died;
+        timed_out += w->timed_out;
+        steals += w->steals;
+        frames += w->frames;
+        sfx_events += w->sfx_events;
+        digest += w->digest;
+        failed |= w->failed;
+        if (w->max_len > max_len) max_len = w->max_len;
+        for (int s = 0; s < SCORE_SLOTS; s++) {
+            scores[s] += w->scores[s];
+            score_sum += (uint64_t)w->scores[s] * s * FOOD_POINTS;
+        }
+    }
+    free(workers);
+
+    printf("games          %u on %d threads (%s input%s), %u steals\n", played, threads,
+           input == INPUT_AI ? "ai" : "fuzz", check ? ", checked" : "", steals);
+    printf("throughput     %.1f games/s, %.0f frames/s (%.3f s)\n",
+           played / elapsed, frames / elapsed, elapsed);
+    printf("outcome        %u won, %u died, %u timed out (cap %u frames)\n", won, died, timed_out, cap);
+    if (played) {
+        printf("score          min %d  p10 %d  p50 %d  p90 %d  max %d  mean %.1f\n",
+               percentile(scores, played, 0.0), percentile(scores, played, 0.1),
+               percentile(scores, played, 0.5), percentile(scores, played, 0.9),
+               percentile(scores, played, 1.0), (double)score_sum / played);
+    }
+    printf("max length     %u/%d, %llu sound effects\n", max_len, BOARD_CELLS,
+           (unsigned long long)sfx_events);
+    printf("digest         %016llx\n", (unsigned long long)digest);
+
+    return failed;
+}
@@ -0,0 +1,154 @@
+// Host benchmark for the portable core (PLATFORM=host only)
+// Runs the same scripted workload as snake-host, first with game_update alone
+// and then with game_update + game_render, and reports the cost per frame.
+// Also times the audio mixer with every channel busy, and compares the core
+// PRNG with the newlib-style rand() % n it replaced (speed and bucket bias).
+// Finally lets the autopilot play one full game - the deterministic
+// max-length workload - and reports the length reached and its decision cost.
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "game.h"
+#include "mixer.h"
+#include "sfx.h"
+#include "rng.h"
+#include "ai.h"
+#include "host.h"
+
+static Game game;
+static Mixer mixer;
+static Ai ai;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Run one pass over the workload, returns elapsed seconds
+static double run(uint32_t frames, int render) {
+    plat_init();
+    host_set_frame_limit(0);
+    game_init(&game);
+    game_seed(&game, 0x12345678);
+
+    double start = now_sec();
+    for (uint32_t f = 0; f < frames; f++) {
+        plat_vblank();
+        game_update(&game, plat_buttons());
+        if (render) game_render(&game);
+    }
+    return now_sec() - start;
+}
+
+// Mix `frames` blocks with all channels playing looped effects, returns elapsed seconds
+static double run_mixer(uint32_t frames) {
+    static int8_t block[MIX_FRAME_SAMPLES];
+    sfx_init();
+    mixer_init(&mixer);
+
+    double start = now_sec();
+    for (uint32_t f = 0; f < frames; f++) {
+        // Worst case: keep every channel busy, restarting effects as they end
+        for (int c = mixer_active(&mixer); c < MIX_CHANNELS; c++) {
+            sfx_play(&mixer, (f + c) % SFX_COUNT);
+        }
+        mixer_mix(&mixer, block, MIX_FRAME_SAMPLES);
+    }
+    return now_sec() - start;
+}
+
+// One autopilot game from the menu until it is won or lost (or `frames` runs
+// out). Only the ai_buttons calls are timed.
+static void run_ai(uint32_t frames) {
+    plat_init();
+    host_set_frame_limit(0);
+    game_init(&game);
+    game_seed(&game, 0x12345678);
+    ai_init(&ai);
+    game_update(&game, GAME_INPUT_DEMO);
+
+    double spent = 0;
+    uint32_t f, max_len = 0;
+    for (f = 0; f < frames && game.state == GAME_PLAYING; f++) {
+        double start = now_sec();
+        uint32_t buttons = ai_buttons(&ai, &game);
+        spent += now_sec() - start;
+        game_update(&game, buttons | GAME_INPUT_DEMO);
+        if (game.snake_len > max_len) max_len = game.snake_len;
+    }
+
+    const char* result = game.state == GAME_WON ? "won" : game.state == GAME_OVER ? "died" : "running";
+    printf("autopilot      %s after %u frames, max length %u/%d, %.1f ns/frame\n",
+           result, f, max_len, BOARD_CELLS, spent * 1e9 / (f ? f : 1));
+}
+
+// newlib rand(): 31-bit LCG, top 15 bits returned (RAND_MAX 0x7FFF on devkitARM)
+static uint32_t lcg_state;
+
+static uint32_t lcg_rand(void) {
+    lcg_state = lcg_state * 1103515245u + 12345u;
+    return (lcg_state >> 16) & 0x7FFF;
+}
+
+#define RNG_BUCKETS 597     // Free cells at the start of a GBA game
+static uint32_t buckets[RNG_BUCKETS];
+
+// Chi-square of the bucket counts against a uniform distribution
+static double chi_square(uint32_t draws) {
+    double expected = (double)draws / RNG_BUCKETS;
+    double chi = 0;
+    for (int i = 0; i < RNG_BUCKETS; i++) {
+        double d = buckets[i] - expected;
+        chi += d * d / expected;
+        buckets[i] = 0;
+    }
+    return chi;
+}
+
+static void run_rng(uint32_t draws) {
+    Rng rng;
+    rng_seed(&rng, 0x12345678);
+    lcg_state = 0x12345678;
+
+    double start = now_sec();
+    for (uint32_t i = 0; i < draws; i++) buckets[rng_range(&rng, RNG_BUCKETS)]++;
+    double core = now_sec() - start;
+    double core_chi = chi_square(draws);
+
+    start = now_sec();
+    for (uint32_t i = 0; i < draws; i++) buckets[lcg_rand() % RNG_BUCKETS]++;
+    double lcg = now_sec() - start;
+    double lcg_chi = chi_square(draws);
+
+    // 596 degrees of freedom: uniform lands near 596 (+-35)
+    printf("rng_range      %.2f ns/draw, chi-square %.0f (%d buckets)\n",
+           core * 1e9 / draws, core_chi, RNG_BUCKETS);
+    printf("rand() %% n     %.2f ns/draw, chi-square %.0f\n", lcg * 1e9 / draws, lcg_chi);
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 10000000;
+
+    printf("sizeof(Game)   %u bytes\n", (unsigned)sizeof(Game));
+
+    double update = run(frames, 0);
+    printf("game_update    %.1f ns/frame (%u frames, %.3f s)\n",
+           update * 1e9 / frames, frames, update);
+
+    double both = run(frames, 1);
+    printf("game_render    %.1f ns/frame\n", (both - update) * 1e9 / frames);
+    printf("total          %.0f frames/s\n", frames / both);
+
+    uint32_t mix_frames = frames / 10 ? frames / 10 : 1;
+    double mix = run_mixer(mix_frames);
+    printf("mixer_mix      %.1f ns/frame (%d channels, %d samples)\n",
+           mix * 1e9 / mix_frames, MIX_CHANNELS, MIX_FRAME_SAMPLES);
+
+    run_rng(frames * 10);
+
+    run_ai(frames);
+
+    return 0;
+}
@@ -0,0 +1,596 @@
+// Lockstep batch engine - scalar reference and SSE2/AVX2 kernels
+#include "lockstep.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LS_X86 1
+#else
+#define LS_X86 0
+#endif
+
+#define BTN_DIRS (BTN_UP | BTN_DOWN | BTN_LEFT | BTN_RIGHT)
+#define HELD_KEYS 0xFF      // Bits of held that track buttons; GAME_INPUT_DEMO is the demo flag
+
+static void* ls_alloc(size_t count, size_t size) {
+    size_t bytes = (count * size + 31) & ~(size_t)31;
+    void* p = aligned_alloc(32, bytes);
+    if (p) memset(p, 0, bytes);
+    return p;
+}
+
+int ls_init(Lockstep* ls, int lanes) {
+    memset(ls, 0, sizeof(Lockstep));
+    lanes = (lanes + LS_LANE_ALIGN - 1) & ~(LS_LANE_ALIGN - 1);
+    ls->lanes = lanes;
+
+    ls->state = ls_alloc(lanes, sizeof(int32_t));
+    ls->held = ls_alloc(lanes, sizeof(uint32_t));
+    ls->frame_count = ls_alloc(lanes, sizeof(uint32_t));
+    ls->move_accum = ls_alloc(lanes, sizeof(uint32_t));
+    ls->move_speed = ls_alloc(lanes, sizeof(uint32_t));
+    ls->dir_x = ls_alloc(lanes, sizeof(int32_t));
+    ls->dir_y = ls_alloc(lanes, sizeof(int32_t));
+    ls->head_x = ls_alloc(lanes, sizeof(int32_t));
+    ls->head_y = ls_alloc(lanes, sizeof(int32_t));
+    ls->food_x = ls_alloc(lanes, sizeof(int32_t));
+    ls->food_y = ls_alloc(lanes, sizeof(int32_t));
+    ls->turn_count = ls_alloc(lanes, sizeof(int32_t));
+    ls->grid = ls_alloc((size_t)lanes * BOARD_H, sizeof(uint32_t));
+    ls->turn_head = ls_alloc(lanes, sizeof(uint8_t));
+    ls->turn_queue = ls_alloc((size_t)lanes * TURN_QUEUE_LEN, sizeof(uint8_t));
+    ls->snake_head = ls_alloc(lanes, sizeof(uint16_t));
+    ls->snake_len = ls_alloc(lanes, sizeof(uint16_t));
+    ls->level = ls_alloc(lanes, sizeof(uint16_t));
+    ls->level_food = ls_alloc(lanes, sizeof(uint8_t));
+    ls->score = ls_alloc(lanes, sizeof(int32_t));
+    ls->rng = ls_alloc(lanes, sizeof(Rng));
+    ls->snake = ls_alloc((size_t)lanes * MAX_SNAKE_LEN, sizeof(Cell));
+    ls->free_count = ls_alloc(lanes, sizeof(uint16_t));
+    ls->free_cells = ls_alloc((size_t)lanes * BOARD_CELLS, sizeof(uint16_t));
+    ls->free_index = ls_alloc((size_t)lanes * BOARD_CELLS, sizeof(uint16_t));
+
+    if (!ls->state || !ls->held || !ls->frame_count || !ls->move_accum || !ls->move_speed ||
+        !ls->dir_x || !ls->dir_y || !ls->head_x || !ls->head_y || !ls->food_x || !ls->food_y ||
+        !ls->turn_count || !ls->grid || !ls->turn_head || !ls->turn_queue || !ls->snake_head ||
+        !ls->snake_len || !ls->level || !ls->level_food || !ls->score || !ls->rng ||
+        !ls->snake || !ls->free_count || !ls->free_cells || !ls->free_index) {
+        ls_free(ls);
+        return 0;
+    }
+
+    for (int i = 0; i < lanes; i++) ls_lane_init(ls, i, 0);
+
+    ls->kernel = LS_KERNEL_SCALAR;
+    ls_set_kernel(ls, LS_KERNEL_SSE2);
+    ls_set_kernel(ls, LS_KERNEL_AVX2);
+    return 1;
+}
+
+void ls_free(Lockstep* ls) {
+    free(ls->state);
+    free(ls->held);
+    free(ls->frame_count);
+    free(ls->move_accum);
+    free(ls->move_speed);
+    free(ls->dir_x);
+    free(ls->dir_y);
+    free(ls->head_x);
+    free(ls->head_y);
+    free(ls->food_x);
+    free(ls->food_y);
+    free(ls->turn_count);
+    free(ls->grid);
+    free(ls->turn_head);
+    free(ls->turn_queue);
+    free(ls->snake_head);
+    free(ls->snake_len);
+    free(ls->level);
+    free(ls->level_food);
+    free(ls->score);
+    free(ls->rng);
+    free(ls->snake);
+    free(ls->free_count);
+    free(ls->free_cells);
+    free(ls->free_index);
+    memset(ls, 0, sizeof(Lockstep));
+}
+
+// Starting snake: three segments heading right from the centre, as in game_init/game_reset
+static void ls_lane_place_snake(Lockstep* ls, int lane) {
+    Cell* snake = &ls->snake[(size_t)lane * MAX_SNAKE_LEN];
+    int center_x = BOARD_W / 2;
+    int center_y = BOARD_H / 2;
+
+    for (int i = 0; i < 3; i++) {
+        snake[i].x = center_x - i;
+        snake[i].y = center_y;
+    }
+    ls->snake_head[lane] = 0;
+    ls->snake_len[lane] = 3;
+    ls->head_x[lane] = center_x;
+    ls->head_y[lane] = center_y;
+    ls->dir_x[lane] = 1;
+    ls->dir_y[lane] = 0;
+    ls->food_x[lane] = center_x + 3;
+    ls->food_y[lane] = center_y;
+    ls->move_accum[lane] = 0;
+    ls->move_speed[lane] = game_level_speed(1);
+    ls->level[lane] = 1;
+}
+
+void ls_lane_init(Lockstep* ls, int lane, uint32_t seed) {
+    memset(&ls->snake[(size_t)lane * MAX_SNAKE_LEN], 0, MAX_SNAKE_LEN * sizeof(Cell));
+    memset(&ls->free_cells[(size_t)lane * BOARD_CELLS], 0, BOARD_CELLS * sizeof(uint16_t));
+    memset(&ls->free_index[(size_t)lane * BOARD_CELLS], 0, BOARD_CELLS * sizeof(uint16_t));
+    memset(&ls->turn_queue[(size_t)lane * TURN_QUEUE_LEN], 0, TURN_QUEUE_LEN);
+    for (int y = 0; y < BOARD_H; y++) ls->grid[(size_t)y * ls->lanes + lane] = 0;
+
+    ls->state[lane] = GAME_MENU;
+    ls->held[lane] = 0;
+    ls->frame_count[lane] = 0;
+    ls->turn_count[lane] = 0;
+    ls->turn_head[lane] = 0;
+    ls->level_food[lane] = 0;
+    ls->score[lane] = 0;
+    ls->free_count[lane] = 0;
+    ls_lane_place_snake(ls, lane);
+    rng_seed(&ls->rng[lane], seed);
+}
+
+// --- Per-lane events (scalar, shared by every kernel) ---
+
+static inline uint32_t* ls_grid_row(Lockstep* ls, int lane, int y) {
+    return &ls->grid[(size_t)y * ls->lanes + lane];
+}
+
+static void ls_cell_occupy(Lockstep* ls, int lane, int cell) {
+    uint16_t* cells = &ls->free_cells[(size_t)lane * BOARD_CELLS];
+    uint16_t* index = &ls->free_index[(size_t)lane * BOARD_CELLS];
+    int count = ls->free_count[lane];
+    int pos = index[cell];
+    int last = cells[count - 1];
+
+    cells[pos] = last;
+    index[last] = pos;
+    cells[count - 1] = cell;
+    index[cell] = count - 1;
+    ls->free_count[lane] = count - 1;
+}
+
+// game_cell_occupy(head) then game_cell_release(tail) - the usual step, which
+// leaves the count unchanged. The three reads do not depend on each other,
+// so this is one round of loads instead of two chains.
+static void ls_cell_swap(Lockstep* ls, int lane, int head, int tail) {
+    uint16_t* cells = &ls->free_cells[(size_t)lane * BOARD_CELLS];
+    uint16_t* index = &ls->free_index[(size_t)lane * BOARD_CELLS];
+    int last_pos = ls->free_count[lane] - 1;
+    int head_pos = index[head];
+    int tail_pos = index[tail];
+    int last = cells[last_pos];
+
+    cells[head_pos] = last;
+    index[last] = head_pos;
+    cells[last_pos] = tail;
+    index[tail] = last_pos;
+    cells[tail_pos] = head;
+    index[head] = tail_pos;
+}
+
+// game_reset
+static void ls_lane_reset(Lockstep* ls, int lane) {
+    uint16_t* cells = &ls->free_cells[(size_t)lane * BOARD_CELLS];
+    uint16_t* index = &ls->free_index[(size_t)lane * BOARD_CELLS];
+    const Cell* snake = &ls->snake[(size_t)lane * MAX_SNAKE_LEN];
+
+    ls->state[lane] = GAME_PLAYING;
+    ls->score[lane] = 0;
+    ls->level_food[lane] = 0;
+    ls->turn_head[lane] = 0;
+    ls->turn_count[lane] = 0;
+    ls_lane_place_snake(ls, lane);
+
+    for (int y = 0; y < BOARD_H; y++) *ls_grid_row(ls, lane, y) = 0;
+    for (int c = 0; c < BOARD_CELLS; c++) {
+        cells[c] = c;
+        index[c] = c;
+    }
+    ls->free_count[lane] = BOARD_CELLS;
+    for (int i = 0; i < 3; i++) {
+        *ls_grid_row(ls, lane, snake[i].y) |= 1u << snake[i].x;
+        ls_cell_occupy(ls, lane, board_cell(snake[i].x, snake[i].y));
+    }
+}
+
+// Demo bit, START handling and turn queueing for a lane with new presses or
+// a GAME_INPUT_DEMO that differs from its demo flag
+static void ls_lane_input(Lockstep* ls, int lane, uint32_t buttons, uint32_t pressed) {
+    // Attract demo, as in game_update: the flag lives in bit 8 of held
+    if ((buttons & GAME_INPUT_DEMO) && !(ls->held[lane] & GAME_INPUT_DEMO)) {
+        if (ls->state[lane] == GAME_MENU) {
+            ls_lane_reset(ls, lane);
+            ls->held[lane] |= GAME_INPUT_DEMO;
+        }
+    } else if (!(buttons & GAME_INPUT_DEMO) && (ls->held[lane] & GAME_INPUT_DEMO)) {
+        ls->held[lane] &= ~GAME_INPUT_DEMO;
+        ls->state[lane] = GAME_MENU;
+        return;
+    }
+
+    if (pressed & BTN_START) {
+        int state = ls->state[lane];
+        if (state == GAME_MENU || state == GAME_OVER || state == GAME_WON) {
+            ls_lane_reset(ls, lane);
+        } else if (state == GAME_PLAYING) {
+            ls->state[lane] = GAME_PAUSED;
+        } else if (state == GAME_PAUSED) {
+            ls->state[lane] = GAME_PLAYING;
+        }
+    }
+    if (ls->state[lane] != GAME_PLAYING || !(pressed & BTN_DIRS)) return;
+
+    static const uint8_t order[4] = { BTN_UP, BTN_DOWN, BTN_LEFT, BTN_RIGHT };
+    uint8_t* queue = &ls->turn_queue[(size_t)lane * TURN_QUEUE_LEN];
+    for (int i = 0; i < 4; i++) {
+        if (!(pressed & order[i])) continue;
+        if (ls->turn_count[lane] == TURN_QUEUE_LEN) return;
+
+        int slot = (ls->turn_head[lane] + ls->turn_count[lane]) & (TURN_QUEUE_LEN - 1);
+        queue[slot] = order[i];
+        ls->turn_count[lane]++;
+    }
+}
+
+// game_apply_turn
+static void ls_lane_apply_turn(Lockstep* ls, int lane) {
+    const uint8_t* queue = &ls->turn_queue[(size_t)lane * TURN_QUEUE_LEN];
+    while (ls->turn_count[lane]) {
+        uint8_t btn = queue[ls->turn_head[lane]];
+        ls->turn_head[lane] = (ls->turn_head[lane] + 1) & (TURN_QUEUE_LEN - 1);
+        ls->turn_count[lane]--;
+
+        int dx = (btn == BTN_RIGHT) - (btn == BTN_LEFT);
+        int dy = (btn == BTN_DOWN) - (btn == BTN_UP);
+        if (dx == -ls->dir_x[lane] && dy == -ls->dir_y[lane]) continue;
+        if (dx == ls->dir_x[lane] && dy == ls->dir_y[lane]) continue;
+
+        ls->dir_x[lane] = dx;
+        ls->dir_y[lane] = dy;
+        return;
+    }
+}
+
+// One movement tick onto a free cell (nx, ny)
+static void ls_lane_advance(Lockstep* ls, int lane, int nx, int ny, int ate_food) {
+    Cell* snake = &ls->snake[(size_t)lane * MAX_SNAKE_LEN];
+    int head = ls->snake_head[lane];
+    int len = ls->snake_len[lane];
+    int tail_index = head + len - 1;
+    if (tail_index >= MAX_SNAKE_LEN) tail_index -= MAX_SNAKE_LEN;
+    Cell tail = snake[tail_index];
+
+    int grow = ate_food && len < MAX_SNAKE_LEN;
+    if (grow) {
+        ls_cell_occupy(ls, lane, board_cell(nx, ny));
+    } else {
+        ls_cell_swap(ls, lane, board_cell(nx, ny), board_cell(tail.x, tail.y));
+        *ls_grid_row(ls, lane, tail.y) &= ~(1u << tail.x);
+    }
+    *ls_grid_row(ls, lane, ny) |= 1u << nx;
+
+    head = head ? head - 1 : MAX_SNAKE_LEN - 1;
+    snake[head].x = nx;
+    snake[head].y = ny;
+    ls->snake_head[lane] = head;
+    ls->head_x[lane] = nx;
+    ls->head_y[lane] = ny;
+
+    if (!ate_food) return;
+    if (grow) ls->snake_len[lane] = len + 1;
+    ls->score[lane] += FOOD_POINTS;
+    if (++ls->level_food[lane] == FOOD_PER_LEVEL) {
+        ls->level_food[lane] = 0;
+        ls->level[lane]++;
+        ls->move_speed[lane] = game_level_speed(ls->level[lane]);
+    }
+
+    // game_spawn_food
+    int count = ls->free_count[lane];
+    if (count == 0) {
+        ls->state[lane] = GAME_WON;
+        return;
+    }
+    int cell = ls->free_cells[(size_t)lane * BOARD_CELLS + rng_range(&ls->rng[lane], count)];
+    ls->food_x[lane] = cell % BOARD_W;
+    ls->food_y[lane] = cell / BOARD_W;
+}
+
+// Start the cache misses of a lane's coming step - its tail slot and the
+// free-set entries - so that a block's stepping lanes overlap them
+static inline void ls_lane_prefetch(const Lockstep* ls, int lane, int nx, int ny) {
+    int tail = ls->snake_head[lane] + ls->snake_len[lane] - 1;
+    if (tail >= MAX_SNAKE_LEN) tail -= MAX_SNAKE_LEN;
+    __builtin_prefetch(&ls->snake[(size_t)lane * MAX_SNAKE_LEN + tail]);
+    __builtin_prefetch(&ls->free_index[(size_t)lane * BOARD_CELLS + board_cell(nx, ny)]);
+    __builtin_prefetch(&ls->free_cells[(size_t)lane * BOARD_CELLS + ls->free_count[lane] - 1]);
+}
+
+// Move onto (nx, ny) unless it is occupied
+static inline void ls_lane_move(Lockstep* ls, int lane, int nx, int ny, int hit, int ate_food) {
+    if (hit) {
+        ls->state[lane] = GAME_OVER;
+        return;
+    }
+    ls_lane_advance(ls, lane, nx, ny, ate_food);
+}
+
+// --- Kernels ---
+
+static void ls_step_scalar(Lockstep* ls, const uint32_t* buttons) {
+    for (int i = 0; i < ls->lanes; i++) {
+        uint32_t held = ls->held[i];
+        uint32_t pressed = buttons[i] & ~held;
+        ls->held[i] = (buttons[i] & HELD_KEYS) | (held & GAME_INPUT_DEMO);
+        ls->frame_count[i]++;
+        if ((pressed & (BTN_START | BTN_DIRS)) || ((buttons[i] ^ held) & GAME_INPUT_DEMO)) {
+            ls_lane_input(ls, i, buttons[i], pressed);
+        }
+
+        if (ls->state[i] != GAME_PLAYING) continue;
+        ls->move_accum[i] += ls->move_speed[i];
+        if (ls->move_accum[i] < FIX_ONE) continue;
+        ls->move_accum[i] -= FIX_ONE;
+
+        if (ls->turn_count[i]) ls_lane_apply_turn(ls, i);
+        int nx = board_wrap_x(ls->head_x[i] + ls->dir_x[i]);
+        int ny = board_wrap_y(ls->head_y[i] + ls->dir_y[i]);
+        int hit = (*ls_grid_row(ls, i, ny) >> nx) & 1;
+        ls_lane_move(ls, i, nx, ny, hit, nx == ls->food_x[i] && ny == ls->food_y[i]);
+    }
+}
+
+#if LS_X86
+
+// Wrap a coordinate vector one cell off the edge back onto the board, as
+// board_wrap_x/y do: a mask for power-of-two sizes, otherwise two compares
+static inline __m128i ls_wrap_sse2(__m128i v, int size, int pow2) {
+    __m128i top = _mm_set1_epi32(size - 1);
+    if (pow2) return _mm_and_si128(v, top);
+    __m128i below = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+    __m128i above = _mm_cmpgt_epi32(v, top);
+    return _mm_or_si128(_mm_andnot_si128(_mm_or_si128(below, above), v), _mm_and_si128(below, top));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i ls_wrap_avx2(__m256i v, int size, int pow2) {
+    __m256i top = _mm256_set1_epi32(size - 1);
+    if (pow2) return _mm256_and_si256(v, top);
+    __m256i below = _mm256_cmpgt_epi32(_mm256_setzero_si256(), v);
+    __m256i above = _mm256_cmpgt_epi32(v, top);
+    return _mm256_or_si256(_mm256_andnot_si256(_mm256_or_si256(below, above), v),
+                           _mm256_and_si256(below, top));
+}
+
+static void ls_step_sse2(Lockstep* ls, const uint32_t* buttons) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i input_mask = _mm_set1_epi32(BTN_START | BTN_DIRS);
+    const __m128i keys_mask = _mm_set1_epi32(HELD_KEYS);
+    const __m128i demo_bit = _mm_set1_epi32(GAME_INPUT_DEMO);
+    const __m128i playing = _mm_set1_epi32(GAME_PLAYING);
+    const __m128i fix_one = _mm_set1_epi32(FIX_ONE);
+    int32_t nx[4], ny[4], hit[4], ate[4];
+    uint32_t pressed[4];
+
+    for (int i = 0; i < ls->lanes; i += 4) {
+        // Edge detection for four lanes
+        __m128i btn = _mm_loadu_si128((const __m128i*)&buttons[i]);
+        __m128i held = _mm_load_si128((const __m128i*)&ls->held[i]);
+        __m128i press = _mm_andnot_si128(held, btn);
+        _mm_store_si128((__m128i*)&ls->held[i], _mm_or_si128(_mm_and_si128(btn, keys_mask),
+                                                              _mm_and_si128(held, demo_bit)));
+        __m128i frames = _mm_load_si128((const __m128i*)&ls->frame_count[i]);
+        _mm_store_si128((__m128i*)&ls->frame_count[i], _mm_add_epi32(frames, one));
+
+        __m128i event = _mm_or_si128(_mm_and_si128(press, input_mask),
+                                     _mm_and_si128(_mm_xor_si128(btn, held), demo_bit));
+        int events = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(event, zero))) ^ 0xF;
+        if (events) {
+            _mm_storeu_si128((__m128i*)pressed, press);
+            for (int l = 0; l < 4; l++) {
+                if (events & (1 << l)) ls_lane_input(ls, i + l, buttons[i + l], pressed[l]);
+            }
+        }
+
+        // Movement timing for the lanes in play
+        __m128i live = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)&ls->state[i]), playing);
+        __m128i speed = _mm_and_si128(_mm_load_si128((const __m128i*)&ls->move_speed[i]), live);
+        __m128i accum = _mm_add_epi32(_mm_load_si128((const __m128i*)&ls->move_accum[i]), speed);
+        __m128i step = _mm_and_si128(live, _mm_cmpgt_epi32(_mm_srli_epi32(accum, FIX_SHIFT), zero));
+        accum = _mm_sub_epi32(accum, _mm_and_si128(step, fix_one));
+        _mm_store_si128((__m128i*)&ls->move_accum[i], accum);
+
+        int steps = _mm_movemask_ps(_mm_castsi128_ps(step));
+        if (!steps) continue;
+        for (int l = 0; l < 4; l++) {
+            if ((steps & (1 << l)) && ls->turn_count[i + l]) ls_lane_apply_turn(ls, i + l);
+        }
+
+        // Next head, wrap, collision and food tests
+        __m128i x = _mm_add_epi32(_mm_load_si128((const __m128i*)&ls->head_x[i]),
+                                  _mm_load_si128((const __m128i*)&ls->dir_x[i]));
+        __m128i y = _mm_add_epi32(_mm_load_si128((const __m128i*)&ls->head_y[i]),
+                                  _mm_load_si128((const __m128i*)&ls->dir_y[i]));
+        x = ls_wrap_sse2(x, BOARD_W, BOARD_W_POW2);
+        y = ls_wrap_sse2(y, BOARD_H, BOARD_H_POW2);
+        _mm_storeu_si128((__m128i*)nx, x);
+        _mm_storeu_si128((__m128i*)ny, y);
+
+        // SSE2 has no per-lane shift: build 1 << x through the float exponent
+        // (2^31 converts to 0x80000000, which is still the right bit)
+        __m128i bit = _mm_cvttps_epi32(_mm_castsi128_ps(
+            _mm_slli_epi32(_mm_add_epi32(x, _mm_set1_epi32(127)), 23)));
+        __m128i row = _mm_set_epi32(*ls_grid_row(ls, i + 3, ny[3]), *ls_grid_row(ls, i + 2, ny[2]),
+                                    *ls_grid_row(ls, i + 1, ny[1]), *ls_grid_row(ls, i, ny[0]));
+        __m128i free_cell = _mm_cmpeq_epi32(_mm_and_si128(row, bit), zero);
+        __m128i food = _mm_and_si128(
+            _mm_cmpeq_epi32(x, _mm_load_si128((const __m128i*)&ls->food_x[i])),
+            _mm_cmpeq_epi32(y, _mm_load_si128((const __m128i*)&ls->food_y[i])));
+        _mm_storeu_si128((__m128i*)hit, _mm_andnot_si128(free_cell, one));
+        _mm_storeu_si128((__m128i*)ate, _mm_and_si128(food, one));
+
+        for (int l = 0; l < 4; l++) {
+            if (steps & (1 << l)) ls_lane_prefetch(ls, i + l, nx[l], ny[l]);
+        }
+        for (int l = 0; l < 4; l++) {
+            if (steps & (1 << l)) ls_lane_move(ls, i + l, nx[l], ny[l], hit[l], ate[l]);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void ls_step_avx2(Lockstep* ls, const uint32_t* buttons) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i input_mask = _mm256_set1_epi32(BTN_START | BTN_DIRS);
+    const __m256i keys_mask = _mm256_set1_epi32(HELD_KEYS);
+    const __m256i demo_bit = _mm256_set1_epi32(GAME_INPUT_DEMO);
+    const __m256i playing = _mm256_set1_epi32(GAME_PLAYING);
+    const __m256i fix_one = _mm256_set1_epi32(FIX_ONE);
+    const __m256i lane_ids = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i stride = _mm256_set1_epi32(ls->lanes);
+    int32_t nx[8], ny[8], hit[8], ate[8];
+    uint32_t pressed[8];
+
+    for (int i = 0; i < ls->lanes; i += 8) {
+        // Edge detection for eight lanes
+        __m256i btn = _mm256_loadu_si256((const __m256i*)&buttons[i]);
+        __m256i held = _mm256_load_si256((const __m256i*)&ls->held[i]);
+        __m256i press = _mm256_andnot_si256(held, btn);
+        _mm256_store_si256((__m256i*)&ls->held[i], _mm256_or_si256(_mm256_and_si256(btn, keys_mask),
+                                                                    _mm256_and_si256(held, demo_bit)));
+        __m256i frames = _mm256_load_si256((const __m256i*)&ls->frame_count[i]);
+        _mm256_store_si256((__m256i*)&ls->frame_count[i], _mm256_add_epi32(frames, one));
+
+        __m256i event = _mm256_or_si256(_mm256_and_si256(press, input_mask),
+                                        _mm256_and_si256(_mm256_xor_si256(btn, held), demo_bit));
+        int events = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(event, zero))) ^ 0xFF;
+        if (events) {
+            _mm256_storeu_si256((__m256i*)pressed, press);
+            for (int l = 0; l < 8; l++) {
+                if (events & (1 << l)) ls_lane_input(ls, i + l, buttons[i + l], pressed[l]);
+            }
+        }
+
+        // Movement timing for the lanes in play
+        __m256i live = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i*)&ls->state[i]), playing);
+        __m256i speed = _mm256_and_si256(_mm256_load_si256((const __m256i*)&ls->move_speed[i]), live);
+        __m256i accum = _mm256_add_epi32(_mm256_load_si256((const __m256i*)&ls->move_accum[i]), speed);
+        __m256i step = _mm256_and_si256(live, _mm256_cmpgt_epi32(_mm256_srli_epi32(accum, FIX_SHIFT), zero));
+        accum = _mm256_sub_epi32(accum, _mm256_and_si256(step, fix_one));
+        _mm256_store_si256((__m256i*)&ls->move_accum[i], accum);
+
+        int steps = _mm256_movemask_ps(_mm256_castsi256_ps(step));
+        if (!steps) continue;
+        for (int l = 0; l < 8; l++) {
+            if ((steps & (1 << l)) && ls->turn_count[i + l]) ls_lane_apply_turn(ls, i + l);
+        }
+
+        // Next head, wrap, collision (gathered grid rows) and food tests
+        __m256i x = _mm256_add_epi32(_mm256_load_si256((const __m256i*)&ls->head_x[i]),
+                                     _mm256_load_si256((const __m256i*)&ls->dir_x[i]));
+        __m256i y = _mm256_add_epi32(_mm256_load_si256((const __m256i*)&ls->head_y[i]),
+                                     _mm256_load_si256((const __m256i*)&ls->dir_y[i]));
+        x = ls_wrap_avx2(x, BOARD_W, BOARD_W_POW2);
+        y = ls_wrap_avx2(y, BOARD_H, BOARD_H_POW2);
+
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(y, stride),
+                                         _mm256_add_epi32(lane_ids, _mm256_set1_epi32(i)));
+        __m256i row = _mm256_mask_i32gather_epi32(zero, (const int*)ls->grid, index, step, 4);
+        __m256i hit_bit = _mm256_and_si256(_mm256_srlv_epi32(row, x), one);
+        __m256i food = _mm256_and_si256(
+            _mm256_cmpeq_epi32(x, _mm256_load_si256((const __m256i*)&ls->food_x[i])),
+            _mm256_cmpeq_epi32(y, _mm256_load_si256((const __m256i*)&ls->food_y[i])));
+        _mm256_storeu_si256((__m256i*)nx, x);
+        _mm256_storeu_si256((__m256i*)ny, y);
+        _mm256_storeu_si256((__m256i*)hit, hit_bit);
+        _mm256_storeu_si256((__m256i*)ate, _mm256_and_si256(food, one));
+
+        for (int l = 0; l < 8; l++) {
+            if (steps & (1 << l)) ls_lane_prefetch(ls, i + l, nx[l], ny[l]);
+        }
+        for (int l = 0; l < 8; l++) {
+            if (steps & (1 << l)) ls_lane_move(ls, i + l, nx[l], ny[l], hit[l], ate[l]);
+        }
+    }
+}
+
+#endif
+
+int ls_set_kernel(Lockstep* ls, LsKernel kernel) {
+    switch (kernel) {
+    case LS_KERNEL_SCALAR:
+        break;
+#if LS_X86
+    case LS_KERNEL_SSE2:
+        if (!__builtin_cpu_supports("sse2")) return 0;
+        break;
+    case LS_KERNEL_AVX2:
+        if (!__builtin_cpu_supports("avx2")) return 0;
+        break;
+#endif
+    default:
+        return 0;
+    }
+    ls->kernel = kernel;
+    return 1;
+}
+
+const char* ls_kernel_name(LsKernel kernel) {
+    static const char* names[LS_KERNEL_COUNT] = { "scalar", "sse2", "avx2" };
+    return kernel < LS_KERNEL_COUNT ? names[kernel] : "?";
+}
+
+void ls_step(Lockstep* ls, const uint32_t* buttons) {
+    switch (ls->kernel) {
+#if LS_X86
+    case LS_KERNEL_SSE2:
+        ls_step_sse2(ls, buttons);
+        return;
+    case LS_KERNEL_AVX2:
+        ls_step_avx2(ls, buttons);
+        return;
+#endif
+    default:
+        ls_step_scalar(ls, buttons);
+        return;
+    }
+}
+
+const char* ls_lane_diff(const Lockstep* ls, int lane, const Game* game) {
+    if (ls->state[lane] != game->state) return "state";
+    if (ls->frame_count[lane] != game->frame_count) return "frame_count";
+    if ((ls->held[lane] & HELD_KEYS) != game->buttons_held) return "buttons_held";
+    if (!(ls->held[lane] & GAME_INPUT_DEMO) != !game->demo) return "demo";
+    if (ls->dir_x[lane] != game->dir_x || ls->dir_y[lane] != game->dir_y) return "direction";
+    if (ls->move_accum[lane] != game->move_accum) return "move_accum";
+    if (ls->move_speed[lane] != game->move_speed) return "move_speed";
+    if (ls->food_x[lane] != game->food.x || ls->food_y[lane] != game->food.y) return "food";
+    if (ls->score[lane] != game->score) return "score";
+    if (ls->level[lane] != game->level || ls->level_food[lane] != game->level_food) return "level";
+    if (ls->turn_count[lane] != game->turn_count || ls->turn_head[lane] != game->turn_head) return "turn queue";
+    if (memcmp(&ls->turn_queue[(size_t)lane * TURN_QUEUE_LEN], game->turn_queue, TURN_QUEUE_LEN) != 0) return "turn queue";
+    if (ls->snake_head[lane] != game->snake_head || ls->snake_len[lane] != game->snake_len) return "snake length";
+    if (memcmp(&ls->snake[(size_t)lane * MAX_SNAKE_LEN], game->snake, sizeof(game->snake)) != 0) return "snake";
+    const Cell* head = &game->snake[game->snake_head];
+    if (ls->head_x[lane] != head->x || ls->head_y[lane] != head->y) return "head";
+    if (memcmp(&ls->rng[lane], &game->rng, sizeof(Rng)) != 0) return "rng";
+    if (ls->free_count[lane] != game->free_count) return "free_count";
+    if (memcmp(&ls->free_cells[(size_t)lane * BOARD_CELLS], game->free_cells, sizeof(game->free_cells)) != 0) return "free_cells";
+    if (memcmp(&ls->free_index[(size_t)lane * BOARD_CELLS], game->free_index, sizeof(game->free_index)) != 0) return "free_index";
+    for (int y = 0; y < BOARD_H; y++) {
+        if (ls->grid[(size_t)y * ls->lanes + lane] != game->grid[y]) return "grid";
+    }
+    return NULL;
+}
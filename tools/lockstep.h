@@ -0,0 +1,79 @@
+// Lockstep batch engine for host tools (PLATFORM=host only)
+// Keeps many games in structure-of-arrays form and advances all of them one
+// frame per ls_step call, following the same rules as game_update so every
+// lane stays bit-exact with a Game fed the same buttons, GAME_INPUT_DEMO
+// included. The per-frame work that every lane does (edge detection,
+// movement timing, wrap, collision and food tests) runs in SSE2 or AVX2
+// kernels; the rare per-lane events (START, the demo bit changing, queued
+// turns, the ring/free-set update on a step, food spawns) drop to scalar
+// code.
+//
+// Not modelled, because game_update never reads them back: BCD/high-score
+// HUD counters, input latency stamps, sound and render state.
+#pragma once
+#include <stdint.h>
+#include "game.h"
+
+typedef enum {
+    LS_KERNEL_SCALAR,
+    LS_KERNEL_SSE2,
+    LS_KERNEL_AVX2,
+    LS_KERNEL_COUNT
+} LsKernel;
+
+#define LS_LANE_ALIGN 8     // Lane count is rounded up to whole AVX2 vectors
+
+typedef struct {
+    int lanes;
+    LsKernel kernel;
+
+    // Hot per-lane fields - one 32-bit word per lane so vectors load directly
+    int32_t* state;             // GameState
+    uint32_t* held;             // Buttons held last frame (low 8 bits, like Game), plus
+                                // GAME_INPUT_DEMO while a demo runs (Game::demo)
+    uint32_t* frame_count;
+    uint32_t* move_accum;
+    uint32_t* move_speed;
+    int32_t* dir_x;
+    int32_t* dir_y;
+    int32_t* head_x;            // Copy of the head segment
+    int32_t* head_y;
+    int32_t* food_x;
+    int32_t* food_y;
+    int32_t* turn_count;
+
+    // Occupancy bitboards, interleaved by lane: bit x of grid[y * lanes + lane]
+    uint32_t* grid;
+
+    // Cold per-lane fields, only touched on events
+    uint8_t* turn_head;
+    uint8_t* turn_queue;        // [lane * TURN_QUEUE_LEN + slot]
+    uint16_t* snake_head;
+    uint16_t* snake_len;
+    uint16_t* level;
+    uint8_t* level_food;
+    int32_t* score;
+    Rng* rng;
+    Cell* snake;                // [lane * MAX_SNAKE_LEN + i]
+    uint16_t* free_count;
+    uint16_t* free_cells;       // [lane * BOARD_CELLS + i]
+    uint16_t* free_index;
+} Lockstep;
+
+// Allocate `lanes` games (rounded up to LS_LANE_ALIGN), all in the menu with
+// seed 0; returns 0 on allocation failure. Picks the fastest kernel the CPU has.
+int ls_init(Lockstep* ls, int lanes);
+void ls_free(Lockstep* ls);
+
+// Same state as game_init followed by game_seed
+void ls_lane_init(Lockstep* ls, int lane, uint32_t seed);
+
+// Select a kernel; returns 0 if this CPU or build cannot run it
+int ls_set_kernel(Lockstep* ls, LsKernel kernel);
+const char* ls_kernel_name(LsKernel kernel);
+
+// Advance every lane one frame - buttons[lane] as passed to game_update
+void ls_step(Lockstep* ls, const uint32_t* buttons);
+
+// First gameplay field where the lane differs from `game`, or NULL if none
+const char* ls_lane_diff(const Lockstep* ls, int lane, const Game* game);
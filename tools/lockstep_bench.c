@@ -0,0 +1,200 @@
+// Lockstep engine benchmark (PLATFORM=host only)
+//
+//   snake-lockstep [lanes] [frames] [--verify]
+//
+// Plays `lanes` games for `frames` frames, first by looping game_update over
+// an array of Game structs and then through ls_step with every kernel this
+// CPU supports, and reports lane-steps per second. Input is a per-lane hash
+// of the frame number: lanes out of play press START now and then, lanes in
+// play mostly steer towards the food with the odd random turn or pause.
+// --verify instead runs both side by side on identical input and checks the
+// lanes stay bit-exact with their Game - once on that input and once with
+// GAME_INPUT_DEMO raised and dropped on a per-lane schedule, so demos start
+// from the menu, get ignored mid-game and end at arbitrary points.
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game.h"
+#include "lockstep.h"
+
+#define LOCKSTEP_SEED 0x12345678
+#define VERIFY_INTERVAL 64      // Frames between full lane comparisons
+
+static Game* games;
+static uint32_t* buttons;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t hash(uint32_t lane, uint32_t frame) {
+    uint32_t z = lane * 0x9E3779B9u ^ frame * 0x85EBCA6Bu;
+    z = (z ^ (z >> 15)) * 0x2C1B3C6Du;
+    z = (z ^ (z >> 12)) * 0x297A2D39u;
+    return z ^ (z >> 15);
+}
+
+static uint32_t lane_keys(uint32_t lane, uint32_t frame, int state, int hx, int hy, int fx, int fy) {
+    uint32_t r = hash(lane, frame);
+    if (state != GAME_PLAYING) return (r & 15) == 0 ? BTN_START : 0;
+    if ((r & 15) != 0) return 0;
+    if ((r >> 2) % 256 == 0) return BTN_START;
+    if (((r >> 10) & 7) == 0) return 1u << ((r >> 13) & 3);
+    if ((r >> 15) & 1 && hx != fx) return hx < fx ? BTN_RIGHT : BTN_LEFT;
+    if (hy != fy) return hy < fy ? BTN_DOWN : BTN_UP;
+    return hx < fx ? BTN_RIGHT : BTN_LEFT;
+}
+
+// Verify pass 2: GAME_INPUT_DEMO held for 300 of every 1024 frames, phase per lane
+static int feed_demo;
+
+static uint32_t lane_input(uint32_t lane, uint32_t frame, int state, int hx, int hy, int fx, int fy) {
+    uint32_t demo = feed_demo && ((frame + lane * 97) & 1023) < 300 ? GAME_INPUT_DEMO : 0;
+    return demo | lane_keys(lane, frame, state, hx, hy, fx, fy);
+}
+
+static void games_init(int lanes) {
+    for (int i = 0; i < lanes; i++) {
+        game_init_hooks(&games[i], NULL, NULL);
+        game_seed(&games[i], LOCKSTEP_SEED + i);
+    }
+}
+
+static void games_input(int lanes, uint32_t frame) {
+    for (int i = 0; i < lanes; i++) {
+        const Game* g = &games[i];
+        const Cell* head = &g->snake[g->snake_head];
+        buttons[i] = lane_input(i, frame, g->state, head->x, head->y, g->food.x, g->food.y);
+    }
+}
+
+static void lockstep_init(Lockstep* ls) {
+    for (int i = 0; i < ls->lanes; i++) ls_lane_init(ls, i, LOCKSTEP_SEED + i);
+}
+
+static void lockstep_input(const Lockstep* ls, uint32_t frame) {
+    for (int i = 0; i < ls->lanes; i++) {
+        buttons[i] = lane_input(i, frame, ls->state[i], ls->head_x[i], ls->head_y[i],
+                                ls->food_x[i], ls->food_y[i]);
+    }
+}
+
+// Seconds spent in game_update over the whole run (input generation excluded)
+static double run_games(int lanes, uint32_t frames, uint32_t* ate) {
+    double spent = 0;
+    games_init(lanes);
+    for (uint32_t f = 0; f < frames; f++) {
+        games_input(lanes, f);
+        double start = now_sec();
+        for (int i = 0; i < lanes; i++) game_update(&games[i], buttons[i]);
+        spent += now_sec() - start;
+    }
+    *ate = 0;
+    for (int i = 0; i < lanes; i++) *ate += games[i].score / FOOD_POINTS;
+    return spent;
+}
+
+static double run_lockstep(Lockstep* ls, uint32_t frames, uint32_t* ate) {
+    double spent = 0;
+    lockstep_init(ls);
+    for (uint32_t f = 0; f < frames; f++) {
+        lockstep_input(ls, f);
+        double start = now_sec();
+        ls_step(ls, buttons);
+        spent += now_sec() - start;
+    }
+    *ate = 0;
+    for (int i = 0; i < ls->lanes; i++) *ate += ls->score[i] / FOOD_POINTS;
+    return spent;
+}
+
+// Step both engines on the same input; returns 0 at the first divergence
+static int verify(Lockstep* ls, uint32_t frames) {
+    games_init(ls->lanes);
+    lockstep_init(ls);
+    for (uint32_t f = 0; f < frames; f++) {
+        games_input(ls->lanes, f);
+        for (int i = 0; i < ls->lanes; i++) game_update(&games[i], buttons[i]);
+        ls_step(ls, buttons);
+
+        if (f % VERIFY_INTERVAL != VERIFY_INTERVAL - 1 && f != frames - 1) continue;
+        for (int i = 0; i < ls->lanes; i++) {
+            const char* field = ls_lane_diff(ls, i, &games[i]);
+            if (field) {
+                printf("%-14s lane %d differs from game_update in %s by frame %u\n",
+                       ls_kernel_name(ls->kernel), i, field, f + 1);
+                return 0;
+            }
+        }
+    }
+    printf("%-14s bit-exact with game_update (%d lanes, %u frames)\n",
+           ls_kernel_name(ls->kernel), ls->lanes, frames);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    int lanes = 1024;
+    uint32_t frames = 20000;
+    int check = 0;
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verify") == 0) check = 1;
+        else if (positional == 0) lanes = atoi(argv[i]), positional++;
+        else if (positional == 1) frames = (uint32_t)strtoul(argv[i], NULL, 0), positional++;
+        else {
+            fprintf(stderr, "usage: snake-lockstep [lanes] [frames] [--verify]\n");
+            return 1;
+        }
+    }
+    if (lanes < 1) lanes = 1;
+
+    Lockstep ls;
+    if (!ls_init(&ls, lanes)) {
+        fprintf(stderr, "lockstep: cannot allocate %d lanes\n", lanes);
+        return 1;
+    }
+    lanes = ls.lanes;
+    games = malloc((size_t)lanes * sizeof(Game));
+    buttons = malloc((size_t)lanes * sizeof(uint32_t));
+    if (!games || !buttons) {
+        fprintf(stderr, "lockstep: out of memory\n");
+        return 1;
+    }
+
+    printf("lanes          %d, %u frames, %dx%d board\n", lanes, frames, BOARD_W, BOARD_H);
+
+    int failed = 0;
+    if (check) {
+        for (int k = 0; k < LS_KERNEL_COUNT; k++) {
+            if (ls_set_kernel(&ls, (LsKernel)k) && !verify(&ls, frames)) failed = 1;
+        }
+        printf("with GAME_INPUT_DEMO\n");
+        feed_demo = 1;
+        for (int k = 0; k < LS_KERNEL_COUNT; k++) {
+            if (ls_set_kernel(&ls, (LsKernel)k) && !verify(&ls, frames)) failed = 1;
+        }
+    } else {
+        double steps = (double)lanes * frames;
+        uint32_t ate;
+        double base = run_games(lanes, frames, &ate);
+        printf("game_update    %.2f ns/step, %.1f M steps/s (%u food)\n",
+               base * 1e9 / steps, steps / base / 1e6, ate);
+
+        for (int k = 0; k < LS_KERNEL_COUNT; k++) {
+            if (!ls_set_kernel(&ls, (LsKernel)k)) continue;
+            double t = run_lockstep(&ls, frames, &ate);
+            printf("ls %-11s %.2f ns/step, %.1f M steps/s (%u food), %.2fx\n",
+                   ls_kernel_name((LsKernel)k), t * 1e9 / steps, steps / t / 1e6, ate, base / t);
+        }
+    }
+
+    free(games);
+    free(buttons);
+    ls_free(&ls);
+    return failed;
+}
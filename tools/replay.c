@@ -0,0 +1,219 @@
+// Host replay recorder / player (PLATFORM=host only)
+//
+//   snake-replay record <file> [frames]   Record the host input script (SNAKE_INPUT
+//                                         or the built-in workload) into a replay
+//   snake-replay play <file> [--render]   Fast-forward a replay at full speed,
+//                                         rendering disabled unless --render
+//   snake-replay check                    Record a built-in session that cuts two
+//                                         attract demos short, play it back and
+//                                         check both runs end in the same state
+//
+// Recording goes through attract mode like main.c, so idle stretches in the
+// input script turn into autopilot demos.
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game.h"
+#include "replay.h"
+#include "attract.h"
+#include "host.h"
+
+#define GAME_SEED 0x12345678
+#define MAX_REPLAY_BYTES (16 * 1024 * 1024)
+#define CHECK_FRAMES 6000
+
+static Game game;
+static Game check_game;
+static Attract attract;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// One frame as main.c runs it: attract mode, record, update
+static int record_frame(Replay* rp, uint32_t buttons) {
+    buttons = attract_input(&attract, &game, buttons);
+    if (!replay_record(rp, buttons)) return 0;
+    game_update(&game, buttons);
+    return 1;
+}
+
+static int record(const char* path, uint32_t frames) {
+    uint8_t* buf = malloc(MAX_REPLAY_BYTES);
+    Replay rp;
+
+    plat_init();
+    host_set_frame_limit(0);
+    game_init(&game);
+    game_seed(&game, GAME_SEED);
+    attract_init(&attract);
+    replay_record_begin(&rp, buf, MAX_REPLAY_BYTES, GAME_SEED, game.gfx);
+
+    for (uint32_t f = 0; f < frames; f++) {
+        plat_vblank();
+        if (!record_frame(&rp, plat_buttons())) break;
+        game_render(&game);
+    }
+    int len = replay_record_end(&rp);
+
+    FILE* out = fopen(path, "wb");
+    if (!out || fwrite(buf, 1, len, out) != (size_t)len) {
+        fprintf(stderr, "replay: cannot write %s\n", path);
+        return 1;
+    }
+    fclose(out);
+    free(buf);
+
+    printf("recorded %u frames into %d bytes (score %d)\n", rp.frames, len, game.score);
+    return 0;
+}
+
+// Feed every recorded frame to `g`; returns the number of frames played
+static uint32_t play_frames(Game* g, Replay* rp, int render) {
+    uint32_t frames = 0;
+    uint32_t buttons;
+    while (replay_next(rp, &buttons)) {
+        game_update(g, buttons);
+        if (render) game_render(g);
+        frames++;
+    }
+    return frames;
+}
+
+static int play(const char* path, int render) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        fprintf(stderr, "replay: cannot open %s\n", path);
+        return 1;
+    }
+    uint8_t* buf = malloc(MAX_REPLAY_BYTES);
+    int len = fread(buf, 1, MAX_REPLAY_BYTES, in);
+    fclose(in);
+
+    Replay rp;
+    if (!replay_play_begin(&rp, buf, len)) {
+        fprintf(stderr, "replay: %s is not a replay\n", path);
+        return 1;
+    }
+
+    plat_init();
+    host_set_frame_limit(0);
+    game_init(&game);
+    if (game.gfx.tiles_w != rp.gfx.tiles_w || game.gfx.tiles_h != rp.gfx.tiles_h) {
+        fprintf(stderr, "replay: recorded on a %dx%d board, this build is %dx%d\n",
+                rp.gfx.tiles_w, rp.gfx.tiles_h, game.gfx.tiles_w, game.gfx.tiles_h);
+        return 1;
+    }
+    game_seed(&game, rp.seed);
+
+    double start = now_sec();
+    uint32_t frames = play_frames(&game, &rp, render);
+    double secs = now_sec() - start;
+
+    printf("played %u/%u frames in %.3f s (%.0f frames/s)\n",
+           frames, rp.frames, secs, secs > 0 ? frames / secs : 0.0);
+    printf("final state %d, score %d, high score %d, length %d\n",
+           game.state, game.score, game.high_score, game.snake_len);
+    free(buf);
+    return 0;
+}
+
+// Built-in input for `check`: idle on the menu until the demo has run for a
+// while, cut it short with A, idle into a second demo and cut that one short
+// with START, then start a game and steer it round in squares
+static uint32_t check_script(uint32_t f) {
+    static const uint32_t steer[4] = { BTN_DOWN, BTN_LEFT, BTN_UP, BTN_RIGHT };
+    const uint32_t first = ATTRACT_DELAY + 300;         // Into the first demo
+    const uint32_t second = first + 5 + ATTRACT_DELAY + 400;
+
+    if (f < first) return 0;
+    if (f < first + 5) return BTN_A;
+    if (f < second) return 0;
+    if (f < second + 3) return BTN_START;
+    if (f < second + 20) return 0;
+    if (f < second + 22) return BTN_START;              // Now the player's game
+    if (f % 40 == 0) return steer[(f / 40) % 4];
+    return 0;
+}
+
+// First gameplay field where the two games differ, or NULL if none
+static const char* game_diff(const Game* a, const Game* b) {
+    if (a->state != b->state) return "state";
+    if (a->demo != b->demo) return "demo";
+    if (a->frame_count != b->frame_count) return "frame_count";
+    if (a->score != b->score) return "score";
+    if (a->high_score != b->high_score) return "high_score";
+    if (a->level != b->level) return "level";
+    if (a->dir_x != b->dir_x || a->dir_y != b->dir_y) return "dir";
+    if (a->move_accum != b->move_accum) return "move_accum";
+    if (a->food.x != b->food.x || a->food.y != b->food.y) return "food";
+    if (memcmp(&a->rng, &b->rng, sizeof(Rng)) != 0) return "rng";
+    if (a->snake_len != b->snake_len) return "snake_len";
+    for (int i = 0; i < a->snake_len; i++) {
+        const Cell* ca = &a->snake[(a->snake_head + i) % MAX_SNAKE_LEN];
+        const Cell* cb = &b->snake[(b->snake_head + i) % MAX_SNAKE_LEN];
+        if (ca->x != cb->x || ca->y != cb->y) return "snake";
+    }
+    return NULL;
+}
+
+static int check(void) {
+    uint8_t* buf = malloc(MAX_REPLAY_BYTES);
+    Replay rp;
+    int demos = 0, cut_short = 0;
+
+    plat_init();
+    host_set_frame_limit(0);
+    game_init_hooks(&game, NULL, NULL);
+    game_seed(&game, GAME_SEED);
+    attract_init(&attract);
+    replay_record_begin(&rp, buf, MAX_REPLAY_BYTES, GAME_SEED, game.gfx);
+
+    for (uint32_t f = 0; f < CHECK_FRAMES; f++) {
+        int was_demo = game.demo;
+        if (!record_frame(&rp, check_script(f))) break;
+        demos += !was_demo && game.demo;
+        cut_short += was_demo && !game.demo && game.state == GAME_MENU;
+    }
+    int len = replay_record_end(&rp);
+
+    game_init_hooks(&check_game, NULL, NULL);
+    replay_play_begin(&rp, buf, len);
+    game_seed(&check_game, rp.seed);
+    uint32_t frames = play_frames(&check_game, &rp, 0);
+    free(buf);
+
+    const char* field = game_diff(&game, &check_game);
+    printf("recorded %u frames (%d demos, %d cut short), played back %u\n",
+           rp.frames, demos, cut_short, frames);
+    if (frames != CHECK_FRAMES || demos < 2 || cut_short < 2 || field) {
+        printf("replay check FAILED%s%s\n", field ? ": playback differs in " : "", field ? field : "");
+        return 1;
+    }
+    printf("replay check passed: playback ends in state %d, score %d, length %d\n",
+           check_game.state, check_game.score, check_game.snake_len);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && strcmp(argv[1], "record") == 0) {
+        uint32_t frames = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 0) : 100000;
+        return record(argv[2], frames);
+    }
+    if (argc >= 3 && strcmp(argv[1], "play") == 0) {
+        int render = argc > 3 && strcmp(argv[3], "--render") == 0;
+        return play(argv[2], render);
+    }
+    if (argc == 2 && strcmp(argv[1], "check") == 0) {
+        return check();
+    }
+
+    fprintf(stderr, "usage: %s record <file> [frames]\n"
+                    "       %s play <file> [--render]\n"
+                    "       %s check\n", argv[0], argv[0], argv[0]);
+    return 1;
+}